@@ -0,0 +1,59 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   archive_generator.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 3:40 PM
+ */
+
+#ifndef STATICLIB_UNZIP_BENCH_ARCHIVE_GENERATOR_HPP
+#define STATICLIB_UNZIP_BENCH_ARCHIVE_GENERATOR_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "../test/zip_writer.hpp"
+
+namespace bench {
+
+// archives are written by the same generator as in tests
+using zip_writer::gen_entry;
+using zip_writer::write_archive;
+
+/**
+ * Generates compressible text data
+ *
+ * @param len data length
+ * @param seed generator seed
+ * @return generated data
+ */
+inline std::string gen_text(size_t len, uint32_t seed = 42) {
+    std::string res;
+    res.reserve(len + 64);
+    uint32_t state = seed;
+    while (res.length() < len) {
+        state = state * 1103515245 + 12345;
+        res += "record " + std::to_string(res.length()) + " value " + std::to_string((state >> 16) % 10000) + "\n";
+    }
+    res.resize(len);
+    return res;
+}
+
+} // namespace
+
+#endif /* STATICLIB_UNZIP_BENCH_ARCHIVE_GENERATOR_HPP */
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   batch_io_bench.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:20 AM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "archive_generator.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+// evicts the file from the page cache, so reads go to the device
+void drop_cache(const std::string& path) {
+#ifndef STATICLIB_WINDOWS
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (-1 != fd) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else // STATICLIB_WINDOWS
+    (void) path;
+#endif // !STATICLIB_WINDOWS
+}
+
+void run(const std::string& label, const std::string& path, const std::vector<std::string>& names,
+        size_t queue_depth, bool cold) {
+    if (cold) {
+        drop_cache(path);
+    }
+    uz::file_index idx{path};
+    uz::batch_options opts;
+    // every selected entry is fetched with a separate read
+    opts.max_gap = 0;
+    opts.io_queue_depth = queue_depth;
+    std::vector<char> buf;
+    buf.resize(1 << 20);
+    size_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto count = uz::read_entries_batch(idx, names, [&](const std::string&, std::istream& stream) {
+        sl::io::streambuf_source src{stream.rdbuf()};
+        auto read = sl::io::read_all(src, {buf.data(), buf.size()});
+        total += read > 0 ? static_cast<size_t>(read) : 0;
+    }, opts);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    double secs = static_cast<double>(elapsed > 0 ? elapsed : 1) / 1000000;
+    std::cout << label << (cold ? "_cold" : "_warm") << ":" <<
+            " queue_depth: [" << queue_depth << "]," <<
+            " reads: [" << count << "]," <<
+            " reads/sec: [" << static_cast<size_t>(static_cast<double>(count) / secs) << "]," <<
+            " MB/sec: [" << static_cast<size_t>(static_cast<double>(total) / secs / (1 << 20)) << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t entries_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    size_t entry_len = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16 << 10;
+    try {
+        std::vector<bench::gen_entry> entries;
+        std::vector<std::string> names;
+        for (size_t i = 0; i < entries_count; i++) {
+            std::string name = "entry_" + std::to_string(i) + ".txt";
+            // every other entry is selected, so reads cannot be merged
+            if (0 == i % 2) {
+                names.push_back(name);
+            }
+            entries.emplace_back(name, bench::gen_text(entry_len, static_cast<uint32_t>(i)));
+        }
+        std::string path = "batch_io_bench.zip";
+        bench::write_archive(path, entries);
+        for (bool cold : {true, false}) {
+            run("pread", path, names, 0, cold);
+            for (size_t depth : {1, 8, 32, 128}) {
+                run("io_uring", path, names, depth, cold);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   codec_bench.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:10 AM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+#include "zstd.h"
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+
+#include "staticlib/io.hpp"
+
+#include "archive_generator.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+const size_t entries_count = 16;
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+std::string zstd_data(const std::string& data) {
+    std::string res;
+    res.resize(ZSTD_compressBound(data.length()));
+    size_t len = ZSTD_compress(std::addressof(res.front()), res.length(), data.data(), data.length(), 3);
+    if (ZSTD_isError(len)) {
+        throw std::runtime_error("ZSTD_compress error");
+    }
+    res.resize(len);
+    return res;
+}
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+
+std::string entry_name(const std::string& method, size_t i) {
+    return method + "/entry_" + std::to_string(i) + ".txt";
+}
+
+// same content is written with every supported method
+std::vector<bench::gen_entry> gen_entries(size_t entry_len, std::vector<std::string>& methods) {
+    std::vector<bench::gen_entry> res;
+    methods.push_back("store");
+    methods.push_back("deflate");
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+    methods.push_back("zstd");
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+    for (size_t i = 0; i < entries_count; i++) {
+        auto data = bench::gen_text(entry_len, static_cast<uint32_t>(i));
+        res.emplace_back(entry_name("store", i), data);
+        res.emplace_back(entry_name("deflate", i), data, true);
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+        res.emplace_back(entry_name("zstd", i), data, uz::zstd_method, zstd_data(data));
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+    }
+    return res;
+}
+
+size_t read_stream(const uz::file_index& idx, const std::string& name, std::vector<char>& buf) {
+    auto stream = uz::open_zip_entry(idx, name);
+    sl::io::streambuf_source src{stream->rdbuf()};
+    auto read = sl::io::read_all(src, {buf.data(), buf.size()});
+    return read > 0 ? static_cast<size_t>(read) : 0;
+}
+
+size_t read_whole(const uz::file_index& idx, const std::string& name, std::vector<char>& buf) {
+    return uz::read_entry_into(idx, name, {buf.data(), buf.size()});
+}
+
+void run(const std::string& label, const uz::file_index& idx, const std::string& method,
+        size_t entry_len, size_t iterations, bool stream) {
+    std::vector<char> buf;
+    buf.resize(entry_len);
+    uint64_t comp_total = 0;
+    for (size_t i = 0; i < entries_count; i++) {
+        comp_total += static_cast<uint64_t>(idx.find_zip_entry(entry_name(method, i)).comp_length);
+    }
+    size_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < entries_count; i++) {
+            auto name = entry_name(method, i);
+            total += stream ? read_stream(idx, name, buf) : read_whole(idx, name, buf);
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    double secs = static_cast<double>(elapsed) / 1000000;
+    double ratio = static_cast<double>(comp_total) / static_cast<double>(entries_count * entry_len);
+    std::cout << label << ": method: [" << method << "]," <<
+            " entry_len: [" << entry_len << "]," <<
+            " ratio: [" << static_cast<size_t>(ratio * 100) << "%]," <<
+            " MB/sec: [" << static_cast<size_t>(static_cast<double>(total) / secs / (1 << 20)) << "]" << std::endl;
+}
+
+void run_size(size_t entry_len, size_t iterations) {
+    std::vector<std::string> methods;
+    auto entries = gen_entries(entry_len, methods);
+    std::string path = "codec_bench_" + std::to_string(entry_len) + ".zip";
+    bench::write_archive(path, entries);
+    uz::file_index_options opts;
+    opts.memory_mapped = true;
+    uz::file_index idx{path, opts};
+    for (auto& method : methods) {
+        run("read_entry_into", idx, method, entry_len, iterations, false);
+        run("stream", idx, method, entry_len, iterations, true);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    try {
+#ifndef STATICLIB_UNZIP_WITH_ZSTD
+        std::cout << "Zstandard support is disabled, only store and deflate are measured" << std::endl;
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+        run_size(64 << 10, iterations);
+        run_size(1 << 20, iterations / 10 + 1);
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_index_bench.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 3:52 PM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "archive_generator.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+// resident set size in bytes, Linux only
+size_t current_rss() {
+    std::ifstream statm{"/proc/self/statm"};
+    size_t pages = 0;
+    size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t lookups = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    try {
+        std::vector<std::string> names;
+        {
+            std::vector<bench::gen_entry> entries;
+            for (size_t i = 0; i < count; i++) {
+                std::ostringstream name{};
+                name << "assets/dir" << (i % 1000) << "/file_" << i << ".txt";
+                names.push_back(name.str());
+                entries.emplace_back(name.str(), "");
+            }
+            bench::write_archive("file_index_bench.zip", entries);
+        }
+        size_t rss_before = current_rss();
+        auto start = std::chrono::steady_clock::now();
+        uz::file_index idx{"file_index_bench.zip"};
+        auto build_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        size_t rss_after = current_rss();
+        uz::file_index_options parallel_opts;
+        parallel_opts.cd_threads_count = 0;
+        start = std::chrono::steady_clock::now();
+        uz::file_index idx_parallel{"file_index_bench.zip", parallel_opts};
+        auto parallel_build_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        uz::file_index_options opts;
+        opts.index_cache_path = "file_index_bench.idx";
+        std::remove(opts.index_cache_path.c_str());
+        uz::file_index idx_cache_write{"file_index_bench.zip", opts};
+        start = std::chrono::steady_clock::now();
+        uz::file_index idx_cached{"file_index_bench.zip", opts};
+        auto cached_build_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        int64_t checksum = 0;
+        for (size_t i = 0; i < lookups; i++) {
+            checksum += idx.find_zip_entry(names[(i * 7919) % names.size()]).offset;
+        }
+        auto lookup_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        std::cout << "entries: [" << count << "]," <<
+                " build_ms: [" << build_us / 1000 << "]," <<
+                " parallel_build_ms: [" << parallel_build_us / 1000 << "]," <<
+                " cached_build_us: [" << cached_build_us << "]," <<
+                " bytes_per_entry: [" << (rss_after - rss_before) / count << "]," <<
+                " lookup_ns: [" << lookup_ns / static_cast<int64_t>(lookups) << "]," <<
+                " checksum: [" << checksum << "]" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
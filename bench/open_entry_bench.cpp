@@ -0,0 +1,151 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   open_entry_bench.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 1:15 PM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/endian.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/compress.hpp"
+#include "staticlib/tinydir.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+// previous implementation: file is opened for every entry
+size_t read_reopen(const uz::file_index& idx, const std::string& name) {
+    auto entry = idx.find_zip_entry(name);
+    sl::tinydir::file_source fd{idx.get_zip_file_path()};
+    fd.seek(entry.offset);
+    std::array<char, 32> skip;
+    sl::endian::read_32_le<uint32_t>(fd);
+    sl::io::skip(fd, skip, 22);
+    uint16_t namelen = sl::endian::read_16_le<uint16_t>(fd);
+    uint16_t exlen = sl::endian::read_16_le<uint16_t>(fd);
+    sl::io::skip(fd, skip, namelen + exlen);
+    std::array<char, 4096> buf;
+    size_t total = 0;
+    if (static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) == entry.comp_method) {
+        auto inflater = sl::compress::make_inflate_source(sl::io::make_reference_source(fd));
+        for (;;) {
+            auto read = sl::io::read_all(inflater, buf);
+            total += static_cast<size_t>(read);
+            if (read < static_cast<std::streamsize>(buf.size())) break;
+        }
+    } else {
+        size_t avail = static_cast<size_t>(entry.comp_length);
+        while (avail > 0) {
+            size_t len = avail < buf.size() ? avail : buf.size();
+            auto read = sl::io::read_all(fd, {buf.data(), len});
+            total += static_cast<size_t>(read);
+            avail -= static_cast<size_t>(read);
+        }
+    }
+    return total;
+}
+
+size_t drain(std::istream& stream) {
+    std::array<char, 4096> buf;
+    size_t total = 0;
+    while (stream.read(buf.data(), buf.size()) || stream.gcount() > 0) {
+        total += static_cast<size_t>(stream.gcount());
+    }
+    return total;
+}
+
+size_t read_shared(const uz::file_index& idx, const std::string& name) {
+    return drain(*uz::open_zip_entry(idx, name));
+}
+
+// entry ids are resolved once, no hashing on open
+size_t read_by_id(const uz::file_index& idx, const uint32_t& id) {
+    return drain(*uz::open_zip_entry(idx, id));
+}
+
+template<typename Key>
+void run(const std::string& label, const uz::file_index& idx, size_t threads_count, size_t iterations,
+        const std::vector<Key>& keys, std::function<size_t(const uz::file_index&, const Key&)> fun) {
+    std::atomic<size_t> opened{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; t++) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < iterations; i++) {
+                for (auto& key : keys) {
+                    fun(idx, key);
+                }
+                opened += keys.size();
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    double secs = static_cast<double>(elapsed) / 1000000;
+    std::cout << label << ": threads: [" << threads_count << "]," <<
+            " opens: [" << opened.load() << "]," <<
+            " opens/sec: [" << static_cast<size_t>(static_cast<double>(opened.load()) / secs) << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "../test/data/bundle.zip";
+    size_t threads_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    size_t iterations = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000;
+    try {
+        uz::file_index idx{path};
+        uz::file_index_options opts;
+        opts.memory_mapped = true;
+        uz::file_index idx_mapped{path, opts};
+        std::vector<std::string> names;
+        std::vector<uint32_t> ids;
+        for (auto& en : idx.get_entries()) {
+            if ('/' != en.back()) {
+                names.push_back(en);
+                ids.push_back(idx.find_entry_id(en));
+            }
+        }
+        run<std::string>("open_per_entry", idx, threads_count, iterations, names, read_reopen);
+        run<std::string>("shared_handle", idx, threads_count, iterations, names, read_shared);
+        run<std::string>("memory_mapped", idx_mapped, threads_count, iterations, names, read_shared);
+        run<uint32_t>("memory_mapped_by_id", idx_mapped, threads_count, iterations, ids, read_by_id);
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
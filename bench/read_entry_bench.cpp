@@ -0,0 +1,112 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   read_entry_bench.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:10 PM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/io.hpp"
+
+#include "archive_generator.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+// whole entry through the stream interface
+size_t read_stream(const uz::file_index& idx, const std::string& name, std::vector<char>& buf) {
+    auto stream = uz::open_zip_entry(idx, name);
+    sl::io::streambuf_source src{stream->rdbuf()};
+    auto read = sl::io::read_all(src, {buf.data(), buf.size()});
+    return read > 0 ? static_cast<size_t>(read) : 0;
+}
+
+size_t read_into(const uz::file_index& idx, const std::string& name, std::vector<char>& buf) {
+    return uz::read_entry_into(idx, name, {buf.data(), buf.size()});
+}
+
+size_t read_vector(const uz::file_index& idx, const std::string& name, std::vector<char>&) {
+    return uz::read_entry(idx, name).size();
+}
+
+void run(const std::string& label, const uz::file_index& idx, const std::vector<std::string>& names,
+        size_t entry_len, size_t iterations,
+        std::function<size_t(const uz::file_index&, const std::string&, std::vector<char>&)> fun) {
+    std::vector<char> buf;
+    buf.resize(entry_len);
+    size_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        for (auto& name : names) {
+            total += fun(idx, name, buf);
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    double secs = static_cast<double>(elapsed) / 1000000;
+    size_t reads = iterations * names.size();
+    std::cout << label << ": entry_len: [" << entry_len << "]," <<
+            " reads: [" << reads << "]," <<
+            " reads/sec: [" << static_cast<size_t>(static_cast<double>(reads) / secs) << "]," <<
+            " MB/sec: [" << static_cast<size_t>(static_cast<double>(total) / secs / (1 << 20)) << "]" << std::endl;
+}
+
+void run_size(size_t entry_len, size_t iterations) {
+    std::vector<bench::gen_entry> entries;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 64; i++) {
+        names.push_back("entry_" + std::to_string(i) + ".txt");
+        entries.emplace_back(names.back(), bench::gen_text(entry_len, static_cast<uint32_t>(i)), true);
+    }
+    std::string path = "read_entry_bench_" + std::to_string(entry_len) + ".zip";
+    bench::write_archive(path, entries);
+    for (bool mapped : {false, true}) {
+        uz::file_index_options opts;
+        opts.memory_mapped = mapped;
+        uz::file_index idx{path, opts};
+        std::string suffix = mapped ? "_mapped" : "";
+        run("stream" + suffix, idx, names, entry_len, iterations, read_stream);
+        run("read_entry_into" + suffix, idx, names, entry_len, iterations, read_into);
+        run("read_entry" + suffix, idx, names, entry_len, iterations, read_vector);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    try {
+        run_size(1 << 10, iterations * 10);
+        run_size(64 << 10, iterations);
+        run_size(1 << 20, iterations / 10 + 1);
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   suite_bench.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:05 AM
+ */
+
+#include "staticlib/unzip.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "archive_generator.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+struct scenario {
+    std::string name;
+    std::function<std::vector<bench::gen_entry>(size_t)> generate;
+};
+
+struct result {
+    size_t entries = 0;
+    uint64_t archive_bytes = 0;
+    uint64_t build_us = 0;
+    int64_t index_bytes = 0;
+    uint64_t lookup_ns = 0;
+    uint64_t open_ns = 0;
+    double throughput_mb_s = 0;
+};
+
+// resident set size in bytes, Linux only
+int64_t current_rss() {
+    std::ifstream statm{"/proc/self/statm"};
+    int64_t pages = 0;
+    int64_t resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096;
+}
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+}
+
+std::vector<bench::gen_entry> tiny_entries(size_t count, bool deflate) {
+    std::vector<bench::gen_entry> res;
+    for (size_t i = 0; i < count; i++) {
+        std::ostringstream name{};
+        name << "assets/dir" << (i % 100) << "/file_" << i << ".txt";
+        res.emplace_back(name.str(), bench::gen_text(100 + i % 400, static_cast<uint32_t>(i)), deflate);
+    }
+    return res;
+}
+
+std::vector<bench::gen_entry> huge_entries(size_t count, size_t size, bool deflate) {
+    std::vector<bench::gen_entry> res;
+    for (size_t i = 0; i < count; i++) {
+        res.emplace_back("data/huge_" + std::to_string(i) + ".bin", bench::gen_text(size, static_cast<uint32_t>(i)),
+                deflate);
+    }
+    return res;
+}
+
+std::vector<bench::gen_entry> deep_entries(size_t count, size_t depth) {
+    std::vector<bench::gen_entry> res;
+    for (size_t i = 0; i < count; i++) {
+        std::ostringstream name{};
+        for (size_t d = 0; d < depth; d++) {
+            name << "level_" << d << "_" << ((i >> d) & 1) << "/";
+        }
+        name << "file_" << i << ".txt";
+        res.emplace_back(name.str(), bench::gen_text(64, static_cast<uint32_t>(i)), true);
+    }
+    return res;
+}
+
+size_t read_entry(const uz::file_index& idx, const std::string& name, std::vector<char>& buf) {
+    auto stream = uz::open_zip_entry(idx, name);
+    size_t total = 0;
+    while (stream->read(buf.data(), buf.size()) || stream->gcount() > 0) {
+        total += static_cast<size_t>(stream->gcount());
+    }
+    return total;
+}
+
+result run(const scenario& sc, size_t scale, size_t lookups) {
+    std::string path = "suite_bench_" + sc.name + ".zip";
+    std::vector<std::string> names;
+    {
+        auto entries = sc.generate(scale);
+        for (auto& en : entries) {
+            names.push_back(en.name);
+        }
+        bench::write_archive(path, entries);
+    }
+    result res;
+    res.entries = names.size();
+    int64_t rss_before = current_rss();
+    auto start = std::chrono::steady_clock::now();
+    uz::file_index idx{path};
+    res.build_us = elapsed_ns(start) / 1000;
+    res.index_bytes = current_rss() - rss_before;
+    res.archive_bytes = idx.get_archive_reader()->size();
+
+    start = std::chrono::steady_clock::now();
+    int64_t checksum = 0;
+    for (size_t i = 0; i < lookups; i++) {
+        checksum += idx.find_zip_entry(names[(i * 7919) % names.size()]).offset;
+    }
+    res.lookup_ns = elapsed_ns(start) / lookups;
+
+    size_t opens = std::min(names.size(), static_cast<size_t>(10000));
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < opens; i++) {
+        auto stream = uz::open_zip_entry(idx, names[(i * 7919) % names.size()]);
+        checksum += stream->get();
+    }
+    res.open_ns = elapsed_ns(start) / opens;
+
+    std::vector<char> buf;
+    buf.resize(1 << 16);
+    uint64_t total = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto& name : names) {
+        total += read_entry(idx, name, buf);
+    }
+    double secs = static_cast<double>(elapsed_ns(start)) / 1000000000;
+    res.throughput_mb_s = static_cast<double>(total) / (1 << 20) / secs;
+    std::remove(path.c_str());
+    if (0 == checksum) {
+        std::cerr << "unexpected checksum" << std::endl;
+    }
+    return res;
+}
+
+std::string to_json(const std::string& name, const result& res) {
+    std::ostringstream out{};
+    out << "{\"scenario\": \"" << name << "\"," <<
+            " \"entries\": " << res.entries << "," <<
+            " \"archive_bytes\": " << res.archive_bytes << "," <<
+            " \"build_us\": " << res.build_us << "," <<
+            " \"index_bytes\": " << res.index_bytes << "," <<
+            " \"lookup_ns\": " << res.lookup_ns << "," <<
+            " \"open_ns\": " << res.open_ns << "," <<
+            " \"throughput_mb_s\": " << static_cast<uint64_t>(res.throughput_mb_s) << "}";
+    return out.str();
+}
+
+} // namespace
+
+// usage: suite_bench [results.jsonl] [scale_percent]
+int main(int argc, char** argv) {
+    std::string out_path = argc > 1 ? argv[1] : "";
+    size_t scale = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    std::vector<scenario> scenarios = {
+        {"tiny_stored", [](size_t sc) { return tiny_entries(1000 * sc, false); }},
+        {"tiny_deflated", [](size_t sc) { return tiny_entries(1000 * sc, true); }},
+        {"huge_stored", [](size_t sc) { return huge_entries(4, (1 << 18) * sc, false); }},
+        {"huge_deflated", [](size_t sc) { return huge_entries(4, (1 << 18) * sc, true); }},
+        {"deep_paths", [](size_t sc) { return deep_entries(200 * sc, 32); }}
+    };
+    try {
+        std::ofstream out;
+        if (!out_path.empty()) {
+            out.open(out_path, std::ios::binary | std::ios::trunc);
+        }
+        for (auto& sc : scenarios) {
+            // one JSON object per line
+            auto line = to_json(sc.name, run(sc, scale > 0 ? scale : 1, 1000000));
+            std::cout << line << std::endl;
+            if (out.is_open()) {
+                out << line << "\n";
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
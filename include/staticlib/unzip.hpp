@@ -27,7 +27,16 @@
 #include "staticlib/config.hpp"
 
 #include "staticlib/unzip/unzip_exception.hpp"
+#include "staticlib/unzip/archive_reader.hpp"
+#include "staticlib/unzip/entry_cache.hpp"
+#include "staticlib/unzip/entry_codec.hpp"
+#include "staticlib/unzip/entry_prefetcher.hpp"
+#include "staticlib/unzip/index_stats.hpp"
 #include "staticlib/unzip/file_index.hpp"
+#include "staticlib/unzip/entry_source.hpp"
+#include "staticlib/unzip/inflate_checkpoints.hpp"
+#include "staticlib/unzip/overlay_index.hpp"
+#include "staticlib/unzip/stream_reader.hpp"
 #include "staticlib/unzip/operations.hpp"
 
 #endif /* STATICLIB_UNZIP_HPP */
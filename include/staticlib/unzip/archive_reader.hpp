@@ -0,0 +1,295 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   archive_reader.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 10:12 AM
+ */
+
+#ifndef STATICLIB_UNZIP_ARCHIVE_READER_HPP
+#define STATICLIB_UNZIP_ARCHIVE_READER_HPP
+
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Random access reader over the ZIP file contents, shared between
+ * the file index and the entry streams opened from it
+ */
+class archive_reader {
+public:
+    /**
+     * Destructor
+     */
+    virtual ~archive_reader() STATICLIB_NOEXCEPT { }
+
+    /**
+     * Reads data starting from the specified position, does not
+     * change any shared state and can be called from multiple threads
+     *
+     * @param position absolute position from the start of the file
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of file
+     */
+    virtual std::streamsize read_at(uint64_t position, sl::io::span<char> span) = 0;
+
+    /**
+     * Returns the size of the ZIP file in bytes
+     *
+     * @return size of the ZIP file
+     */
+    virtual uint64_t size() = 0;
+
+    /**
+     * Returns a view over the whole ZIP file contents if they are accessible
+     * directly from memory (memory-mapped), empty span otherwise
+     *
+     * @return view over the ZIP file contents
+     */
+    virtual sl::io::span<const char> data() {
+        return sl::io::span<const char>(nullptr, 0);
+    }
+
+    /**
+     * Returns the descriptor of the open ZIP file, used to submit
+     * positional reads directly to the kernel in batches
+     *
+     * @return file descriptor, -1 if this reader is not backed by a file descriptor
+     */
+    virtual int file_descriptor() {
+        return -1;
+    }
+
+    /**
+     * Returns a path to the ZIP file, used for error reporting
+     *
+     * @return path to the ZIP file
+     */
+    virtual const std::string& path() = 0;
+};
+
+/**
+ * Source that reads the specified range of the ZIP file through the shared
+ * archive reader, keeps its own position so multiple sources can read
+ * the same file concurrently
+ */
+class archive_range_source {
+    std::shared_ptr<archive_reader> reader;
+    uint64_t position;
+    uint64_t limit;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param reader archive reader
+     * @param position start position of the range
+     * @param length length of the range
+     */
+    archive_range_source(std::shared_ptr<archive_reader> reader, uint64_t position, uint64_t length) :
+    reader(std::move(reader)),
+    position(position),
+    limit(position + length) { }
+
+    /**
+     * Reads data from the range
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of range
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        if (position >= limit) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = limit - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::streamsize res = reader->read_at(position, {span.data(), len});
+        if (res > 0) {
+            position += static_cast<uint64_t>(res);
+        }
+        return res;
+    }
+
+    /**
+     * Returns current absolute position
+     *
+     * @return current position
+     */
+    uint64_t get_position() const {
+        return position;
+    }
+};
+
+/**
+ * Reader over any seekable "sl::io" source, source must provide "read" method
+ * and "seek(offset, whence)" method with 'b' (beginning) "whence" support.
+ * Reads are serialized, because the source has a single position.
+ */
+template<typename Source>
+class source_reader : public archive_reader {
+    std::mutex mtx;
+    Source src;
+    uint64_t src_size;
+    std::string name;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src seekable source over the ZIP file contents
+     * @param size size of the ZIP file contents
+     * @param name name of the source, used for error reporting
+     */
+    source_reader(Source&& src, uint64_t size, std::string name) :
+    src(std::move(src)),
+    src_size(size),
+    name(std::move(name)) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    source_reader(const source_reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    source_reader& operator=(const source_reader&) = delete;
+
+    /**
+     * Seeks the source to the specified position and reads data from it
+     *
+     * @param position absolute position from the start of the contents
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of contents
+     */
+    std::streamsize read_at(uint64_t position, sl::io::span<char> span) override {
+        if (position >= src_size) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = src_size - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::lock_guard<std::mutex> guard{mtx};
+        src.seek(static_cast<std::streamsize>(position), 'b');
+        return src.read({span.data(), len});
+    }
+
+    /**
+     * Returns the size of the contents
+     *
+     * @return size of the contents
+     */
+    uint64_t size() override {
+        return src_size;
+    }
+
+    /**
+     * Returns the name of the source
+     *
+     * @return name of the source
+     */
+    const std::string& path() override {
+        return name;
+    }
+};
+
+/**
+ * Creates reader over the specified seekable source
+ *
+ * @param src seekable source over the ZIP file contents
+ * @param size size of the ZIP file contents
+ * @param name name of the source, used for error reporting
+ * @return source reader
+ */
+template<typename Source>
+std::shared_ptr<archive_reader> make_source_reader(Source&& src, uint64_t size, std::string name = "source") {
+    return std::make_shared<source_reader<typename std::remove_reference<Source>::type>>(
+            std::move(src), size, std::move(name));
+}
+
+/**
+ * Creates reader over the ZIP file contents held in memory by the caller,
+ * data is not copied and must outlive the reader and all the indices
+ * and entry streams using it
+ *
+ * @param data ZIP file contents
+ * @param name name of the contents, used for error reporting
+ * @return memory reader
+ */
+std::shared_ptr<archive_reader> make_memory_reader(sl::io::span<const char> data, std::string name = "memory");
+
+/**
+ * Creates reader over the ZIP file contents held in memory, reader
+ * keeps the specified data alive
+ *
+ * @param data ZIP file contents
+ * @param name name of the contents, used for error reporting
+ * @return memory reader
+ */
+std::shared_ptr<archive_reader> make_memory_reader(std::shared_ptr<const std::vector<char>> data,
+        std::string name = "memory");
+
+/**
+ * Creates reader over the specified range of the parent reader, positions
+ * are translated onto the parent, contents view is a part of the parent
+ * view if the parent contents are in memory
+ *
+ * @param parent parent reader
+ * @param offset start of the range in the parent contents
+ * @param length length of the range
+ * @param name name of the range, used for error reporting
+ * @return range reader
+ * @throws unzip_exception if range is outside of the parent contents
+ */
+std::shared_ptr<archive_reader> make_range_reader(std::shared_ptr<archive_reader> parent, uint64_t offset,
+        uint64_t length, std::string name);
+
+/**
+ * Opens the specified ZIP file for positional reads, single file handle
+ * is shared by all the readers of the returned instance
+ *
+ * @param zip_file_path path to the ZIP file
+ * @return file reader
+ */
+std::shared_ptr<archive_reader> make_file_reader(const std::string& zip_file_path);
+
+/**
+ * Maps the specified ZIP file into memory, mapping is read-only and
+ * is released when the last reference to the returned reader is destroyed
+ *
+ * @param zip_file_path path to the ZIP file
+ * @return memory-mapped reader
+ */
+std::shared_ptr<archive_reader> make_mapped_reader(const std::string& zip_file_path);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ARCHIVE_READER_HPP */
+
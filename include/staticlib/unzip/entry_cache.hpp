@@ -0,0 +1,132 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_cache.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 9:02 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ENTRY_CACHE_HPP
+#define STATICLIB_UNZIP_ENTRY_CACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "staticlib/pimpl.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Snapshot of the entry cache counters
+ */
+struct entry_cache_stats {
+    /**
+     * Number of lookups that found the entry in cache
+     */
+    uint64_t hits = 0;
+    /**
+     * Number of lookups that did not find the entry in cache
+     */
+    uint64_t misses = 0;
+    /**
+     * Number of entries evicted to stay within the memory budget
+     */
+    uint64_t evictions = 0;
+    /**
+     * Number of entries currently cached
+     */
+    size_t entries_count = 0;
+    /**
+     * Number of decompressed bytes currently cached
+     */
+    size_t bytes_used = 0;
+};
+
+/**
+ * Thread-safe LRU cache of the decompressed entries data, keys are the entry
+ * offsets in the ZIP file. Cache is split into independently locked shards,
+ * each shard gets an equal part of the memory budget.
+ */
+class entry_cache : public sl::pimpl::object {
+protected:
+    /**
+     * Implementation class
+     */
+    class impl;
+public:
+    /**
+     * PIMPL-specific constructor
+     * 
+     * @param pimpl impl object
+     */
+    PIMPL_CONSTRUCTOR(entry_cache)
+
+    /**
+     * Constructor
+     * 
+     * @param budget maximum number of decompressed bytes kept in cache
+     * @param entry_max_size entries larger than this are never cached
+     */
+    entry_cache(size_t budget, size_t entry_max_size);
+
+    /**
+     * Returns cached data for the specified entry, marks the entry as recently used
+     * 
+     * @param key entry offset in the ZIP file
+     * @return cached data, null if entry is not cached
+     */
+    std::shared_ptr<const std::vector<char>> get(uint64_t key);
+
+    /**
+     * Puts data for the specified entry into cache, least recently used entries
+     * are evicted to stay within the budget
+     * 
+     * @param key entry offset in the ZIP file
+     * @param data decompressed entry data
+     * @return data that is cached now for this entry (it may be put by
+     *         another thread concurrently), or the specified data if it
+     *         is too large to be cached
+     */
+    std::shared_ptr<const std::vector<char>> put(uint64_t key, std::shared_ptr<const std::vector<char>> data);
+
+    /**
+     * Returns maximum size of the entry that can be cached
+     * 
+     * @return maximum entry size in bytes
+     */
+    size_t get_entry_max_size() const;
+
+    /**
+     * Returns snapshot of the cache counters
+     * 
+     * @return cache counters
+     */
+    entry_cache_stats get_stats() const;
+
+    /**
+     * Removes all the entries from cache, counters are preserved
+     */
+    void clear();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ENTRY_CACHE_HPP */
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_codec.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 11:20 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ENTRY_CODEC_HPP
+#define STATICLIB_UNZIP_ENTRY_CODEC_HPP
+
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Compression method of the Zstandard-compressed ZIP entries
+ */
+const uint16_t zstd_method = 93;
+
+/**
+ * Source of the entry data with the virtual "read" method, used by
+ * codecs both for the compressed input and for the decompressed output
+ */
+class codec_source {
+public:
+    /**
+     * Destructor
+     */
+    virtual ~codec_source() STATICLIB_NOEXCEPT { }
+
+    /**
+     * Reads data
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of data
+     */
+    virtual std::streamsize read(sl::io::span<char> span) = 0;
+};
+
+/**
+ * Codec source over any "sl::io" source
+ */
+template<typename Source>
+class codec_source_adapter : public codec_source {
+    Source src;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src source to wrap
+     */
+    explicit codec_source_adapter(Source&& src) :
+    src(std::move(src)) { }
+
+    /**
+     * Reads data from the wrapped source
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of data
+     */
+    std::streamsize read(sl::io::span<char> span) override {
+        return src.read(span);
+    }
+
+    /**
+     * Underlying source accessor
+     *
+     * @return underlying source
+     */
+    Source& get_source() {
+        return src;
+    }
+};
+
+/**
+ * Wraps the specified "sl::io" source into the codec source
+ *
+ * @param src source to wrap
+ * @return codec source
+ */
+template<typename Source>
+std::unique_ptr<codec_source> make_codec_source(Source&& src) {
+    return std::unique_ptr<codec_source>(new codec_source_adapter<
+            typename std::remove_reference<Source>::type>(std::move(src)));
+}
+
+/**
+ * Decompressor for a single ZIP compression method, codec instances are
+ * shared between threads and must not keep any per-entry state
+ */
+class entry_codec {
+public:
+    /**
+     * Destructor
+     */
+    virtual ~entry_codec() STATICLIB_NOEXCEPT { }
+
+    /**
+     * Returns codec name, used for error reporting
+     *
+     * @return codec name
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * Opens streaming decoder over the compressed entry data, decoder
+     * must return EOF after the specified number of bytes
+     *
+     * @param compressed source over the compressed entry data
+     * @param uncomp_length uncompressed entry length
+     * @return source over the decompressed entry data
+     */
+    virtual std::unique_ptr<codec_source> open_decoder(std::unique_ptr<codec_source> compressed,
+            uint64_t uncomp_length) const = 0;
+
+    /**
+     * Decompresses the whole entry from memory
+     *
+     * @param in compressed entry data
+     * @param out output buffer sized to the uncompressed entry length
+     * @throws unzip_exception if data is invalid or its length does not match the output
+     */
+    virtual void decode(sl::io::span<const char> in, sl::io::span<char> out) const = 0;
+};
+
+/**
+ * Registers codec for the specified compression method, replaces previously
+ * registered codec. "store" and "deflate" are always decoded natively and cannot
+ * be replaced. Registered codecs are used by all the entry streams
+ * and reads opened after this call.
+ *
+ * @param comp_method ZIP compression method
+ * @param codec codec instance
+ * @throws unzip_exception on attempt to replace the native method
+ */
+void register_codec(uint16_t comp_method, std::shared_ptr<const entry_codec> codec);
+
+/**
+ * Finds codec registered for the specified compression method,
+ * "deflate" codec and "zstd" codec (when built with Zstandard support)
+ * are registered by default
+ *
+ * @param comp_method ZIP compression method
+ * @return codec instance, null if the method is not supported
+ */
+std::shared_ptr<const entry_codec> find_codec(uint16_t comp_method);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ENTRY_CODEC_HPP */
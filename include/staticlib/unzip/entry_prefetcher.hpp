@@ -0,0 +1,147 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_prefetcher.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 8:30 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ENTRY_PREFETCHER_HPP
+#define STATICLIB_UNZIP_ENTRY_PREFETCHER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/pimpl.hpp"
+
+#include "staticlib/unzip/file_index.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Options for the background prefetching of ZIP entries
+ */
+struct prefetch_options {
+    /**
+     * Number of background threads decompressing the entries
+     */
+    size_t threads_count = 2;
+
+    /**
+     * Maximum number of decompressed bytes held by the prefetcher, including
+     * the entries being decompressed, entries larger than this are not prefetched
+     */
+    size_t buffer_budget = 64 << 20;
+};
+
+/**
+ * Snapshot of the prefetcher counters
+ */
+struct prefetch_stats {
+    /**
+     * Number of requested entries that were prefetched
+     */
+    uint64_t hits = 0;
+    /**
+     * Number of requested entries that were not prefetched
+     */
+    uint64_t misses = 0;
+    /**
+     * Number of prefetched entries dropped without being requested
+     */
+    uint64_t wasted = 0;
+    /**
+     * Number of decompressed bytes currently held
+     */
+    size_t bytes_buffered = 0;
+};
+
+/**
+ * Decompresses the entries that are expected to be read next on the background
+ * threads. Hinted names are treated as a sequence: taking an entry drops all the
+ * entries hinted before it, so wrong hints release the buffer instead of blocking
+ * the workers. Index must outlive the prefetcher.
+ */
+class entry_prefetcher : public sl::pimpl::object {
+protected:
+    /**
+     * Implementation class
+     */
+    class impl;
+public:
+    /**
+     * PIMPL-specific constructor
+     *
+     * @param pimpl impl object
+     */
+    PIMPL_CONSTRUCTOR(entry_prefetcher)
+
+    /**
+     * Constructor, starts background threads
+     *
+     * @param idx ZIP file index
+     * @param options prefetch options
+     */
+    entry_prefetcher(const file_index& idx, prefetch_options options);
+
+    /**
+     * Replaces the sequence of entries expected to be read next, entries
+     * not found in the index are ignored, data prefetched for the previous
+     * sequence is dropped
+     *
+     * @param entry_names names of ZIP entries in the expected read order
+     */
+    void hint(const std::vector<std::string>& entry_names);
+
+    /**
+     * Drops all the hints and the prefetched data, entries being
+     * decompressed at the moment are dropped when they are finished
+     */
+    void cancel();
+
+    /**
+     * Takes the prefetched data of the specified entry, waits if the entry
+     * is being decompressed at the moment
+     *
+     * @param entry_name ZIP entry name
+     * @return decompressed entry data, null if entry was not prefetched
+     */
+    std::shared_ptr<const std::vector<char>> take(const std::string& entry_name);
+
+    /**
+     * Returns index this prefetcher reads from
+     *
+     * @return ZIP file index
+     */
+    const file_index& get_index() const;
+
+    /**
+     * Returns snapshot of the prefetcher counters
+     *
+     * @return prefetcher counters
+     */
+    prefetch_stats get_stats() const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ENTRY_PREFETCHER_HPP */
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_source.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:45 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ENTRY_SOURCE_HPP
+#define STATICLIB_UNZIP_ENTRY_SOURCE_HPP
+
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/pimpl.hpp"
+#include "staticlib/support.hpp"
+// do not includes zlib.h
+#include "staticlib/compress/zip_compression_method.hpp"
+
+#include "staticlib/unzip/entry_codec.hpp"
+#include "staticlib/unzip/file_index.hpp"
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Source over the decompressed ZIP entry data, compression method is
+ * a template parameter, only "store" and "deflate" specializations are defined.
+ * Entry sources are move-only and can be composed directly with
+ * the other "sl::io" sources and sinks. Stored entries are read inline,
+ * deflated entries are inflated by the library through "entry_inflater".
+ */
+template<typename Source, sl::compress::zip_compression_method Method>
+class entry_source;
+
+/**
+ * Source over the ZIP entry stored without compression
+ */
+template<typename Source>
+class entry_source<Source, sl::compress::zip_compression_method::store> {
+    Source src;
+    uint64_t avail;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src source over the entry data
+     * @param uncomp_length uncompressed entry length
+     */
+    entry_source(Source&& src, uint64_t uncomp_length) :
+    src(std::move(src)),
+    avail(uncomp_length) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    entry_source(const entry_source&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    entry_source& operator=(const entry_source&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    entry_source(entry_source&& other) :
+    src(std::move(other.src)),
+    avail(other.avail) {
+        other.avail = 0;
+    }
+
+    /**
+     * Reads entry data
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of entry
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        if (0 == avail) {
+            return std::char_traits<char>::eof();
+        }
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::streamsize res = src.read({span.data(), len});
+        if (res > 0) {
+            avail -= static_cast<uint64_t>(res);
+        }
+        return res;
+    }
+
+    /**
+     * Underlying source accessor
+     *
+     * @return underlying source
+     */
+    Source& get_source() {
+        return src;
+    }
+};
+
+/**
+ * Inflater over the compressed entry data, zlib stream state is kept
+ * in the library, so this header does not require zlib headers
+ */
+class entry_inflater : public sl::pimpl::object {
+protected:
+    /**
+     * Implementation class
+     */
+    class impl;
+public:
+    /**
+     * PIMPL-specific constructor
+     *
+     * @param pimpl impl object
+     */
+    PIMPL_CONSTRUCTOR(entry_inflater)
+
+    /**
+     * Constructor
+     *
+     * @param compressed source over the compressed entry data
+     * @param uncomp_length uncompressed entry length
+     */
+    entry_inflater(std::unique_ptr<codec_source> compressed, uint64_t uncomp_length);
+
+    /**
+     * Reads and inflates entry data
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of entry
+     */
+    std::streamsize read(sl::io::span<char> span);
+};
+
+/**
+ * Source over the deflated ZIP entry
+ */
+template<typename Source>
+class entry_source<Source, sl::compress::zip_compression_method::deflate> {
+    // owned by the inflater, adapter is allocated on heap and is not moved
+    Source* src_ptr;
+    entry_inflater inflater;
+
+    entry_source(codec_source_adapter<Source>* adapter, uint64_t uncomp_length) :
+    src_ptr(std::addressof(adapter->get_source())),
+    inflater(std::unique_ptr<codec_source>(adapter), uncomp_length) { }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src source over the compressed entry data
+     * @param uncomp_length uncompressed entry length
+     */
+    entry_source(Source&& src, uint64_t uncomp_length) :
+    entry_source(new codec_source_adapter<Source>(std::move(src)), uncomp_length) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    entry_source(const entry_source&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    entry_source& operator=(const entry_source&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    entry_source(entry_source&& other) :
+    src_ptr(other.src_ptr),
+    inflater(std::move(other.inflater)) {
+        other.src_ptr = nullptr;
+    }
+
+    /**
+     * Reads and inflates entry data
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of entry
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        return inflater.read(span);
+    }
+
+    /**
+     * Underlying source accessor
+     *
+     * @return underlying source
+     */
+    Source& get_source() {
+        return *src_ptr;
+    }
+};
+
+/**
+ * Creates entry source for the specified entry, compression method
+ * of the entry must match the specified one
+ *
+ * @param src source over the compressed entry data
+ * @param entry entry description
+ * @return entry source
+ * @throws unzip_exception on compression method mismatch
+ */
+template<sl::compress::zip_compression_method Method, typename Source>
+entry_source<typename std::remove_reference<Source>::type, Method> make_entry_source(Source&& src,
+        const file_entry& entry) {
+    if (static_cast<uint16_t>(Method) != entry.comp_method) throw unzip_exception(TRACEMSG(
+            "Invalid compression method: [" + sl::support::to_string(entry.comp_method) + "]," +
+            " expected: [" + sl::support::to_string(static_cast<uint16_t>(Method)) + "]"));
+    if (sl::compress::zip_compression_method::store == Method && entry.comp_length != entry.uncomp_length) {
+        throw unzip_exception(TRACEMSG(
+                "Invalid stored entry, compressed length: [" + sl::support::to_string(entry.comp_length) + "]," +
+                " uncompressed length: [" + sl::support::to_string(entry.uncomp_length) + "]"));
+    }
+    return entry_source<typename std::remove_reference<Source>::type, Method>(
+            std::move(src), static_cast<uint64_t>(entry.uncomp_length));
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ENTRY_SOURCE_HPP */
@@ -24,6 +24,7 @@
 #ifndef STATICLIB_UNZIP_FILE_INDEX_HPP
 #define STATICLIB_UNZIP_FILE_INDEX_HPP
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,9 +35,18 @@
 // do not includes zlib.h
 #include "staticlib/compress/zip_compression_method.hpp"
 
+#include "staticlib/unzip/archive_reader.hpp"
+#include "staticlib/unzip/entry_cache.hpp"
+#include "staticlib/unzip/index_stats.hpp"
+
 namespace staticlib {
 namespace unzip {
 
+/**
+ * Entry id returned by lookups when the entry is not found
+ */
+const uint32_t invalid_entry_id = 0xffffffff;
+
 /**
  * Represents ZIP file entry
  */
@@ -44,19 +54,23 @@ struct file_entry {
     /**
      * Entry data offset from the start of the file
      */
-    int32_t offset = -1;
+    int64_t offset = -1;
     /**
      * Compressed length
      */
-    int32_t comp_length = -1;
+    int64_t comp_length = -1;
     /**
      * Uncompressed length
      */
-    int32_t uncomp_length = -1;
+    int64_t uncomp_length = -1;
     /**
      * Compression method
      */
     uint16_t comp_method = 0;
+    /**
+     * CRC-32 of the uncompressed data
+     */
+    uint32_t crc = 0;
 
     /**
      * Constructor, constructs an empty entry
@@ -70,12 +84,15 @@ struct file_entry {
      * @param comp_length compressed length
      * @param uncomp_length uncompressed length
      * @param comp_method compression method
+     * @param crc CRC-32 of the uncompressed data
      */
-    file_entry(int32_t offset, int32_t comp_length, int32_t uncomp_length, uint16_t comp_method) :
+    file_entry(int64_t offset, int64_t comp_length, int64_t uncomp_length, uint16_t comp_method,
+            uint32_t crc = 0) :
     offset(offset),
     comp_length(comp_length),
     uncomp_length(uncomp_length),
-    comp_method(comp_method) { }
+    comp_method(comp_method),
+    crc(crc) { }
 
     /**
      * Returns true if this instance represents an empty (invalid) entry
@@ -87,6 +104,63 @@ struct file_entry {
     }
 };
 
+/**
+ * Options for building the index over the ZIP file
+ */
+struct file_index_options {
+    /**
+     * Whether to map the whole ZIP file into memory, entries of memory-mapped
+     * index are read directly from the mapping instead of the shared file handle
+     */
+    bool memory_mapped = false;
+
+    /**
+     * Path to the index cache file, if specified, the index is loaded from this
+     * file (memory-mapped) when it matches the ZIP file size, modification time
+     * and the central directory location; otherwise the central directory is
+     * parsed and the cache file is rewritten
+     */
+    std::string index_cache_path;
+
+    /**
+     * Memory budget in bytes for the cache of decompressed entries shared by
+     * all the streams opened from this index, cache is disabled if zero is specified
+     */
+    size_t entry_cache_budget = 0;
+
+    /**
+     * Entries with uncompressed size larger than this are not cached
+     */
+    size_t entry_cache_max_entry_size = 1 << 20;
+
+    /**
+     * Whether to collect the index counters, counters are updated
+     * with relaxed atomics by the index and by all the streams opened from it
+     */
+    bool collect_stats = false;
+
+    /**
+     * Whether to verify CRC-32 of the decompressed data on sequential entry reads,
+     * mismatch is reported with "unzip_exception" when the end of entry is reached
+     */
+    bool verify_crc = false;
+
+    /**
+     * Whether to parse the central directory lazily, only the end of central
+     * directory record is read on construction, records are parsed on lookups
+     * until the requested entry is found; ignored when the index cache is used
+     */
+    bool lazy = false;
+
+    /**
+     * Number of threads parsing the central directory, large central directories
+     * are read into memory at once and their records are decoded in chunks
+     * concurrently; hardware concurrency is used if zero is specified,
+     * directory is parsed sequentially if one is specified
+     */
+    size_t cd_threads_count = 1;
+};
+
 /**
  * Represents an index over the entries inside the ZIP file
  */
@@ -111,6 +185,32 @@ public:
      */
     file_index(std::string zip_file_path);
 
+    /**
+     * Constructor
+     * 
+     * @param zip_file_path path to the ZIP file
+     * @param options index options
+     */
+    file_index(std::string zip_file_path, file_index_options options);
+
+    /**
+     * Constructor, builds the index over the contents provided by the
+     * specified reader (for example, "make_memory_reader" over the archive held in memory)
+     * 
+     * @param reader reader over the ZIP file contents
+     */
+    file_index(std::shared_ptr<archive_reader> reader);
+
+    /**
+     * Constructor, builds the index over the contents provided by the specified
+     * reader, "memory_mapped" option is ignored, entries are read directly from
+     * memory if the reader provides the "data()" view
+     * 
+     * @param reader reader over the ZIP file contents
+     * @param options index options
+     */
+    file_index(std::shared_ptr<archive_reader> reader, file_index_options options);
+
     /**
      * Returns the ZIP entry with the specified name
      * 
@@ -118,9 +218,45 @@ public:
      * @return ZIP entry with the specified name, empty entry if not found
      */
     file_entry find_zip_entry(const std::string& name) const;
+
+    /**
+     * Returns the ZIP entry with the specified name, name is not copied
+     * 
+     * @param name pointer to the name of ZIP entry
+     * @param name_len name length
+     * @return ZIP entry with the specified name, empty entry if not found
+     */
+    file_entry find_zip_entry(const char* name, size_t name_len) const;
+
+    /**
+     * Returns the id of the ZIP entry with the specified name, see "get_entry_name"
+     * 
+     * @param name name of ZIP entry
+     * @return entry id, "invalid_entry_id" if not found
+     */
+    uint32_t find_entry_id(const std::string& name) const;
+
+    /**
+     * Returns the id of the ZIP entry with the specified name, name is not copied
+     * 
+     * @param name pointer to the name of ZIP entry
+     * @param name_len name length
+     * @return entry id, "invalid_entry_id" if not found
+     */
+    uint32_t find_entry_id(const char* name, size_t name_len) const;
+
+    /**
+     * Returns the ZIP entry with the specified id without the name lookup
+     * 
+     * @param id entry id
+     * @return ZIP entry with the specified id
+     * @throws unzip_exception if id is out of range
+     */
+    file_entry get_zip_entry(uint32_t id) const;
     
     /**
-     * Returns a path to the ZIP file
+     * Returns a path to the ZIP file, or the reader name
+     * for the index built over the archive reader
      * 
      * @return a path to the ZIP file
      */
@@ -132,6 +268,99 @@ public:
      * @return list of ZIP entries names
      */
     const std::vector<std::string>& get_entries() const;
+
+    /**
+     * Returns the number of ZIP entries, valid entry ids are below this number,
+     * names list is not materialized
+     * 
+     * @return number of ZIP entries
+     */
+    size_t get_entries_count() const;
+
+    /**
+     * Returns the name of the entry with the specified id, entry ids are positions
+     * of entries in the central directory (the same as in "get_entries()" list)
+     * and are stable for the lifetime of this index
+     * 
+     * @param id entry id
+     * @return view over the entry name, valid while this index is alive
+     * @throws unzip_exception if id is out of range
+     */
+    sl::io::span<const char> get_entry_name(uint32_t id) const;
+
+    /**
+     * Returns ids of the entries with names starting with the specified prefix, sorted by name.
+     * Sorted names index is built on the first listing call, each call takes O(log n).
+     * 
+     * @param prefix names prefix, empty prefix matches all the entries
+     * @return view over the sorted entry ids, valid while this index is alive
+     */
+    sl::io::span<const uint32_t> list_prefix(const std::string& prefix) const;
+
+    /**
+     * Returns names of the immediate children of the specified directory sorted by name,
+     * subdirectories are returned with the trailing slash, including implicit directories
+     * that have no own entries
+     * 
+     * @param dir directory name with or without the trailing slash, empty for the root directory
+     * @return views over the children names, valid while this index is alive
+     */
+    std::vector<sl::io::span<const char>> list_directory(const std::string& dir) const;
+
+    /**
+     * Returns ids of the entries with names matching the specified glob pattern sorted by name,
+     * "*" and "?" do not match slashes, "**" as a whole path segment matches any number
+     * of directories;
+     * only the entries under the literal prefix of the pattern are checked
+     * 
+     * @param pattern glob pattern
+     * @return sorted entry ids
+     */
+    std::vector<uint32_t> list_glob(const std::string& pattern) const;
+
+    /**
+     * Returns true if the ZIP file is mapped into memory or the index
+     * is built over the reader with directly accessible contents
+     * 
+     * @return true if the ZIP file contents are in memory, false otherwise
+     */
+    bool is_memory_mapped() const;
+
+    /**
+     * Returns true if CRC-32 of the entries data is verified on sequential reads
+     * 
+     * @return true if CRC-32 is verified, false otherwise
+     */
+    bool is_crc_verified() const;
+
+    /**
+     * Returns a reader over the ZIP file, reader is shared between this index
+     * and all the entry streams opened from it and can outlive this index
+     * 
+     * @return reader over the ZIP file
+     */
+    std::shared_ptr<archive_reader> get_archive_reader() const;
+
+    /**
+     * Returns the cache of decompressed entries used by this index
+     * 
+     * @return entry cache, null if cache is disabled
+     */
+    std::shared_ptr<entry_cache> get_entry_cache() const;
+
+    /**
+     * Returns snapshot of the index counters
+     * 
+     * @return index counters, all zero if stats collection is disabled
+     */
+    file_index_stats get_stats() const;
+
+    /**
+     * Returns the collector of the index counters, used by the entry streams
+     * 
+     * @return stats collector, null if stats collection is disabled
+     */
+    std::shared_ptr<index_stats> get_stats_collector() const;
 };
 
 } // namespace
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   index_stats.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:20 AM
+ */
+
+#ifndef STATICLIB_UNZIP_INDEX_STATS_HPP
+#define STATICLIB_UNZIP_INDEX_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Number of buckets in the "open_zip_entry" latency histogram, bucket "i"
+ * counts calls that took less than "2^i" microseconds (and not less than
+ * "2^(i-1)"), the last bucket counts all the slower calls
+ */
+const size_t open_latency_buckets = 16;
+
+/**
+ * Snapshot of the file index counters
+ */
+struct file_index_stats {
+    /**
+     * Time spent locating and parsing (or loading from cache) the central directory in microseconds
+     */
+    uint64_t build_time_us = 0;
+    /**
+     * Number of central directory bytes parsed, zero if index was loaded from cache
+     */
+    uint64_t cd_bytes_parsed = 0;
+    /**
+     * Number of opened stored entries
+     */
+    uint64_t opened_stored = 0;
+    /**
+     * Number of opened deflated entries
+     */
+    uint64_t opened_deflated = 0;
+    /**
+     * Number of opened entries compressed with other methods
+     */
+    uint64_t opened_other = 0;
+    /**
+     * Number of compressed (as stored in the ZIP file) bytes read from entries
+     */
+    uint64_t comp_bytes_read = 0;
+    /**
+     * Number of decompressed bytes returned from entries
+     */
+    uint64_t uncomp_bytes_read = 0;
+    /**
+     * Cumulative time spent inflating or decoding compressed entries data in nanoseconds
+     */
+    uint64_t inflate_time_ns = 0;
+    /**
+     * Number of local file headers that failed to be read or parsed
+     */
+    uint64_t local_header_failures = 0;
+    /**
+     * Histogram of "open_zip_entry" call latencies
+     */
+    std::array<uint64_t, open_latency_buckets> open_latency_histogram;
+
+    /**
+     * Constructor
+     */
+    file_index_stats() {
+        open_latency_histogram.fill(0);
+    }
+};
+
+/**
+ * Lock-free collector of the file index counters, shared by the index and
+ * by all the streams opened from it, all updates use relaxed atomics
+ */
+class index_stats {
+    std::atomic<uint64_t> build_time_us{0};
+    std::atomic<uint64_t> cd_bytes_parsed{0};
+    std::atomic<uint64_t> opened_stored{0};
+    std::atomic<uint64_t> opened_deflated{0};
+    std::atomic<uint64_t> opened_other{0};
+    std::atomic<uint64_t> comp_bytes_read{0};
+    std::atomic<uint64_t> uncomp_bytes_read{0};
+    std::atomic<uint64_t> inflate_time_ns{0};
+    std::atomic<uint64_t> local_header_failures{0};
+    std::array<std::atomic<uint64_t>, open_latency_buckets> open_latency_histogram;
+
+public:
+    /**
+     * Constructor
+     */
+    index_stats();
+
+    /**
+     * Deleted copy constructor
+     */
+    index_stats(const index_stats&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    index_stats& operator=(const index_stats&) = delete;
+
+    /**
+     * Records index construction
+     *
+     * @param time_us construction time in microseconds
+     * @param cd_bytes number of central directory bytes parsed
+     */
+    void record_build(uint64_t time_us, uint64_t cd_bytes);
+
+    /**
+     * Records central directory bytes parsed after the index construction
+     *
+     * @param cd_bytes number of central directory bytes parsed
+     */
+    void record_cd_bytes(uint64_t cd_bytes);
+
+    /**
+     * Records opened entry
+     *
+     * @param comp_method compression method of the entry
+     */
+    void record_open(uint16_t comp_method);
+
+    /**
+     * Records "open_zip_entry" call latency
+     *
+     * @param latency_ns call latency in nanoseconds
+     */
+    void record_open_latency(uint64_t latency_ns);
+
+    /**
+     * Records data read from entry
+     *
+     * @param comp_bytes number of compressed bytes read from the ZIP file
+     * @param uncomp_bytes number of decompressed bytes returned
+     */
+    void record_read(uint64_t comp_bytes, uint64_t uncomp_bytes);
+
+    /**
+     * Records time spent in inflating or decoding with the registered codec
+     *
+     * @param time_ns time in nanoseconds
+     */
+    void record_inflate_time(uint64_t time_ns);
+
+    /**
+     * Records failed read or parse of local file header
+     */
+    void record_local_header_failure();
+
+    /**
+     * Returns snapshot of the counters, counters are read independently
+     * so the snapshot is not atomic as a whole
+     *
+     * @return snapshot of the counters
+     */
+    file_index_stats snapshot() const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_INDEX_STATS_HPP */
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   inflate_checkpoints.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:20 PM
+ */
+
+#ifndef STATICLIB_UNZIP_INFLATE_CHECKPOINTS_HPP
+#define STATICLIB_UNZIP_INFLATE_CHECKPOINTS_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Inflate state saved at the deflate block boundary, allows to restart
+ * decompression from the middle of the entry
+ */
+struct inflate_checkpoint {
+    /**
+     * Position in the uncompressed entry data
+     */
+    uint64_t out_pos = 0;
+    /**
+     * Position in the compressed entry data, relative to the start of data
+     */
+    uint64_t in_pos = 0;
+    /**
+     * Number of bits of the byte preceding "in_pos" that are not yet consumed
+     */
+    int bits = 0;
+    /**
+     * Uncompressed data preceding "out_pos", up to 32 KiB
+     */
+    std::vector<char> window;
+};
+
+/**
+ * Index of inflate checkpoints for a single deflated ZIP entry, similar to
+ * the index built by the "zran" example from zlib. Checkpoints are added
+ * by the seekable entry streams while they inflate the entry sequentially,
+ * single index can be shared by multiple streams (including concurrent ones)
+ * of the same entry and kept between them as a cache.
+ */
+class inflate_checkpoints {
+    uint64_t interval;
+    mutable std::mutex mtx;
+    std::vector<inflate_checkpoint> points;
+    bool complete = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param interval minimal distance between checkpoints in uncompressed bytes,
+     *        the cost of a seek is bounded by the decompression of this amount of data
+     */
+    explicit inflate_checkpoints(uint64_t interval = 1 << 20);
+
+    /**
+     * Deleted copy constructor
+     */
+    inflate_checkpoints(const inflate_checkpoints&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    inflate_checkpoints& operator=(const inflate_checkpoints&) = delete;
+
+    /**
+     * Minimal distance between checkpoints
+     *
+     * @return interval in uncompressed bytes
+     */
+    uint64_t get_interval() const;
+
+    /**
+     * Number of checkpoints stored
+     *
+     * @return number of checkpoints
+     */
+    size_t size() const;
+
+    /**
+     * Whether the whole entry was covered with checkpoints
+     *
+     * @return true if the entry was inflated to the end
+     */
+    bool is_complete() const;
+
+    /**
+     * Uncompressed position of the last checkpoint
+     *
+     * @return position of the last checkpoint, zero if there are no checkpoints
+     */
+    uint64_t last_position() const;
+
+    /**
+     * Adds a checkpoint, it is ignored if it is not at least one interval
+     * after the last stored checkpoint
+     *
+     * @param point checkpoint
+     * @return true if checkpoint was stored
+     */
+    bool add(inflate_checkpoint&& point);
+
+    /**
+     * Finds the last checkpoint at or before the specified position
+     *
+     * @param out_pos position in the uncompressed entry data
+     * @param point_out checkpoint is copied here if found
+     * @return true if checkpoint was found
+     */
+    bool find(uint64_t out_pos, inflate_checkpoint& point_out) const;
+
+    /**
+     * Marks the whole entry as covered with checkpoints
+     */
+    void set_complete();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_INFLATE_CHECKPOINTS_HPP */
@@ -24,15 +24,109 @@
 #ifndef STATICLIB_UNZIP_OPERATIONS_HPP
 #define STATICLIB_UNZIP_OPERATIONS_HPP
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <istream>
 #include <string>
+#include <vector>
 
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/unzip/archive_reader.hpp"
+#include "staticlib/unzip/entry_prefetcher.hpp"
+#include "staticlib/unzip/entry_source.hpp"
 #include "staticlib/unzip/file_index.hpp"
+#include "staticlib/unzip/inflate_checkpoints.hpp"
+#include "staticlib/unzip/overlay_index.hpp"
 
 namespace staticlib {
 namespace unzip {
 
+/**
+ * Options for the bulk extraction of ZIP entries
+ */
+struct extract_options {
+    /**
+     * Number of worker threads, hardware concurrency is used if zero is specified
+     */
+    size_t threads_count = 0;
+
+    /**
+     * Maximum number of reads submitted to the kernel at once through
+     * "io_uring" by each worker thread, zero to stream the entries with
+     * the synchronous positional reads, ignored if the library is built
+     * without "io_uring" support, if it is not available on the running
+     * kernel or if the ZIP file is memory-mapped
+     */
+    size_t io_queue_depth = 0;
+
+    /**
+     * Maximum total length of the buffers of the reads in flight
+     * submitted through "io_uring", shared by all the worker threads
+     */
+    size_t io_buffer_budget = 64 << 20;
+};
+
+/**
+ * Options for the CRC-32 verification of ZIP entries
+ */
+struct verify_options {
+    /**
+     * Number of worker threads, hardware concurrency is used if zero is specified
+     */
+    size_t threads_count = 0;
+};
+
+/**
+ * Result of the CRC-32 verification of ZIP entries
+ */
+struct verify_result {
+    /**
+     * Number of verified file entries
+     */
+    size_t entries_count = 0;
+    /**
+     * Number of decompressed bytes checked
+     */
+    uint64_t bytes_count = 0;
+    /**
+     * Sorted names of the entries that failed verification
+     */
+    std::vector<std::string> failed_entries;
+};
+
+/**
+ * Options for the batch reading of ZIP entries
+ */
+struct batch_options {
+    /**
+     * Maximum length of a single read from the ZIP file, entries
+     * larger than this are streamed separately
+     */
+    size_t max_read_size = 8 << 20;
+
+    /**
+     * Maximum distance between the adjacent entries that are still
+     * fetched with a single read, bytes in between are read and discarded
+     */
+    size_t max_gap = 64 << 10;
+
+    /**
+     * Maximum number of reads submitted to the kernel at once through
+     * "io_uring", zero to use the synchronous positional reads, ignored
+     * if the library is built without "io_uring" support or if it is
+     * not available on the running kernel
+     */
+    size_t io_queue_depth = 0;
+
+    /**
+     * Maximum total length of the buffers of the reads in flight
+     * submitted through "io_uring"
+     */
+    size_t io_buffer_budget = 64 << 20;
+};
+
 /**
  * Opens "input stream" to the specified ZIP entry in the ZIP file corresponding to
  * the specified index
@@ -43,6 +137,205 @@ namespace unzip {
  */
 std::unique_ptr<std::istream> open_zip_entry(const file_index& idx, const std::string& entry_name);
 
+/**
+ * Opens "input stream" to the specified ZIP entry, data prefetched by the
+ * specified prefetcher is returned without reading the ZIP file, entries that
+ * were not prefetched are opened from the index of the prefetcher
+ * 
+ * @param prefetcher entry prefetcher
+ * @param entry_name ZIP entry name
+ * @return unique pointer to the input stream
+ */
+std::unique_ptr<std::istream> open_zip_entry(entry_prefetcher& prefetcher, const std::string& entry_name);
+
+/**
+ * Opens "input stream" to the ZIP entry with the specified id, entry
+ * is not looked up by name, ids can be obtained once with "find_entry_id"
+ * or from the listings and reused for the lifetime of the index
+ * 
+ * @param idx ZIP file index
+ * @param entry_id ZIP entry id
+ * @return unique pointer to the input stream
+ */
+std::unique_ptr<std::istream> open_zip_entry(const file_index& idx, uint32_t entry_id);
+
+/**
+ * Opens "input stream" to the specified ZIP entry in the winning layer of
+ * the specified overlay index, the entry is resolved with a single lookup
+ * 
+ * @param overlay overlay index
+ * @param entry_name ZIP entry name
+ * @return unique pointer to the input stream
+ */
+std::unique_ptr<std::istream> open_zip_entry(const overlay_index& overlay, const std::string& entry_name);
+
+/**
+ * Opens source over the raw (compressed) data of the specified ZIP entry,
+ * can be wrapped into "entry_source" with "make_entry_source" to read
+ * the entry without the virtual dispatch of "std::istream"
+ * 
+ * @param idx ZIP file index
+ * @param entry_name ZIP entry name
+ * @return source over the entry data
+ * @throws unzip_exception if entry is not found or its local header is invalid
+ */
+archive_range_source open_zip_entry_data(const file_index& idx, const std::string& entry_name);
+
+/**
+ * Opens seekable "input stream" to the specified ZIP entry, stored entries
+ * are seeked directly, deflated entries are inflated starting from the nearest
+ * checkpoint preceding the target position. Missing checkpoints are recorded
+ * into the specified index while the entry is read sequentially.
+ * 
+ * @param idx ZIP file index
+ * @param entry_name ZIP entry name
+ * @param checkpoints checkpoints index for this entry, can be shared between
+ *        streams of the same entry, new index is created if not specified
+ * @return unique pointer to the seekable stream
+ */
+std::unique_ptr<std::istream> open_zip_entry_seekable(const file_index& idx, const std::string& entry_name,
+        std::shared_ptr<inflate_checkpoints> checkpoints = std::shared_ptr<inflate_checkpoints>());
+
+/**
+ * Inflates the specified ZIP entry once to build the complete checkpoints index
+ * for it, returned index can be kept to make the seeks in subsequently opened
+ * streams cost no more than one interval of decompression
+ * 
+ * @param idx ZIP file index
+ * @param entry_name ZIP entry name
+ * @param interval distance between checkpoints in uncompressed bytes
+ * @return checkpoints index
+ * @throws unzip_exception if entry is not found or cannot be inflated
+ */
+std::shared_ptr<inflate_checkpoints> build_inflate_checkpoints(const file_index& idx,
+        const std::string& entry_name, uint64_t interval = 1 << 20);
+
+/**
+ * Builds the index over the ZIP archive nested as an entry of the specified index.
+ * Index over the stored entry reads directly from the outer archive with
+ * translated offsets (and is memory-mapped if the outer index is), compressed
+ * entries are decompressed into memory held by the returned index.
+ * 
+ * @param outer index of the outer ZIP file
+ * @param entry_name name of the entry containing the nested ZIP archive
+ * @param options options for the nested index, "memory_mapped" option is ignored
+ * @return index over the nested ZIP archive
+ * @throws unzip_exception if entry is not found or is not a valid ZIP archive
+ */
+file_index open_nested_index(const file_index& outer, const std::string& entry_name,
+        file_index_options options = file_index_options());
+
+/**
+ * Returns a read-only view over the data of the specified ZIP entry stored
+ * without compression, view points directly into the memory-mapped ZIP file
+ * and is valid as long as the archive reader of the index is alive
+ * 
+ * @param idx memory-mapped ZIP file index
+ * @param entry_name ZIP entry name
+ * @return view over the entry data
+ * @throws unzip_exception if index is not memory-mapped or entry is compressed
+ */
+sl::io::span<const char> view_zip_entry(const file_index& idx, const std::string& entry_name);
+
+/**
+ * Returns a read-only view over the raw (compressed) data of the specified
+ * ZIP entry, can be wrapped into "entry_source" over "sl::io::array_source"
+ * to decompress the entry from memory without copying the compressed data
+ * 
+ * @param idx memory-mapped ZIP file index
+ * @param entry_name ZIP entry name
+ * @return view over the raw entry data
+ * @throws unzip_exception if index is not memory-mapped or entry is not found
+ */
+sl::io::span<const char> view_zip_entry_data(const file_index& idx, const std::string& entry_name);
+
+/**
+ * Decompresses the whole specified ZIP entry into the specified buffer,
+ * stored entries are read with a single read, deflated entries are
+ * inflated in one pass from the complete compressed data
+ * 
+ * @param idx ZIP file index
+ * @param entry_name ZIP entry name
+ * @param buffer destination buffer, must not be smaller than the entry
+ * @return number of bytes written, equals to the uncompressed entry size
+ * @throws unzip_exception if entry is not found, buffer is too small or data is invalid
+ */
+size_t read_entry_into(const file_index& idx, const std::string& entry_name, sl::io::span<char> buffer);
+
+/**
+ * Decompresses the whole specified ZIP entry into a vector sized
+ * to the uncompressed entry size, see "read_entry_into"
+ * 
+ * @param idx ZIP file index
+ * @param entry_name ZIP entry name
+ * @return entry data
+ * @throws unzip_exception if entry is not found or data is invalid
+ */
+std::vector<char> read_entry(const file_index& idx, const std::string& entry_name);
+
+/**
+ * Decompresses all the file entries of the ZIP file using a pool of worker
+ * threads and checks their lengths and CRC-32 values against the central
+ * directory, larger entries are verified first
+ * 
+ * @param idx ZIP file index
+ * @param options verification options
+ * @return verification result with the names of invalid entries
+ */
+verify_result verify_archive(const file_index& idx, verify_options options = verify_options());
+
+/**
+ * Reads the specified ZIP entries in the order of their offsets in the ZIP file,
+ * local headers and data of the adjacent entries are fetched with large
+ * sequential reads, then each entry is decompressed from memory and passed
+ * to the specified callback
+ * 
+ * @param idx ZIP file index
+ * @param entry_names names of ZIP entries to read
+ * @param callback function called with the entry name and the stream
+ *        of decompressed entry data, stream is only valid during the call
+ * @param options batch options
+ * @return number of entries read
+ * @throws unzip_exception if entry is not found or on IO error
+ */
+size_t read_entries_batch(const file_index& idx, const std::vector<std::string>& entry_names,
+        std::function<void(const std::string&, std::istream&)> callback, batch_options options = batch_options());
+
+/**
+ * Extracts all the entries of the ZIP file into the specified directory
+ * using a pool of worker threads, larger entries are extracted first,
+ * output files are preallocated to the uncompressed entry size. With
+ * "io_uring" each worker extracts a contiguous range of entries in the
+ * offset order, reading them in batches like "read_entries_batch".
+ * Entries with empty names are skipped, names with parent directory
+ * references, absolute paths or backslashes are rejected, on Windows
+ * names with colons are rejected too.
+ * 
+ * @param idx ZIP file index
+ * @param dest_dir destination directory, created if not exists
+ * @param options extraction options
+ * @return number of extracted file entries
+ * @throws unzip_exception on invalid entry name or IO error
+ */
+size_t extract_all(const file_index& idx, const std::string& dest_dir,
+        extract_options options = extract_options());
+
+/**
+ * Extracts the entries of the ZIP file accepted by the specified filter into
+ * the specified directory using a pool of worker threads, larger entries are
+ * extracted first, output files are preallocated to the uncompressed entry size,
+ * "io_uring" is used the same way as in "extract_all"
+ * 
+ * @param idx ZIP file index
+ * @param dest_dir destination directory, created if not exists
+ * @param filter predicate called with the name of each entry
+ * @param options extraction options
+ * @return number of extracted file entries
+ * @throws unzip_exception on invalid entry name or IO error
+ */
+size_t extract_matching(const file_index& idx, const std::string& dest_dir,
+        std::function<bool(const std::string&)> filter, extract_options options = extract_options());
+
 } // namespace
 }
 
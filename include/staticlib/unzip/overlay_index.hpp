@@ -0,0 +1,185 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   overlay_index.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:05 AM
+ */
+
+#ifndef STATICLIB_UNZIP_OVERLAY_INDEX_HPP
+#define STATICLIB_UNZIP_OVERLAY_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/io/span.hpp"
+#include "staticlib/pimpl.hpp"
+
+#include "staticlib/unzip/file_index.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * ZIP entry resolved by the overlay index
+ */
+struct overlay_entry {
+    /**
+     * Position of the archive (layer) containing the entry
+     */
+    size_t layer = 0;
+    /**
+     * Entry id inside the layer index
+     */
+    uint32_t id = 0;
+    /**
+     * Entry description from the layer index
+     */
+    file_entry entry;
+
+    /**
+     * Returns true if this instance represents an empty (not found) entry
+     *
+     * @return true if this instance represents an empty entry, false otherwise
+     */
+    bool is_empty() {
+        return entry.is_empty();
+    }
+};
+
+/**
+ * Merged index over the ordered list of ZIP files (layers), entries
+ * of the earlier layers shadow the entries with the same names in
+ * the later layers. Lookups take a single hash probe regardless
+ * of the number of layers. Entry ids of the overlay are positions
+ * in the merged entries list: winning entries of the first layer
+ * in the central directory order, then the remaining entries of
+ * the second layer and so on.
+ */
+class overlay_index : public sl::pimpl::object {
+protected:
+    /**
+     * Implementation class
+     */
+    class impl;
+public:
+    /**
+     * PIMPL-specific constructor
+     *
+     * @param pimpl impl object
+     */
+    PIMPL_CONSTRUCTOR(overlay_index)
+
+    /**
+     * Constructor, merges the entries of the specified indices
+     *
+     * @param layers ZIP file indices in the priority order, the first one wins
+     */
+    overlay_index(std::vector<file_index> layers);
+
+    /**
+     * Resolves the entry with the specified name to the winning layer
+     *
+     * @param name name of ZIP entry
+     * @return resolved entry, empty entry if not found in any layer
+     */
+    overlay_entry find_entry(const std::string& name) const;
+
+    /**
+     * Resolves the entry with the specified name to the winning layer, name is not copied
+     *
+     * @param name pointer to the name of ZIP entry
+     * @param name_len name length
+     * @return resolved entry, empty entry if not found in any layer
+     */
+    overlay_entry find_entry(const char* name, size_t name_len) const;
+
+    /**
+     * Returns the number of layers
+     *
+     * @return number of layers
+     */
+    size_t get_layers_count() const;
+
+    /**
+     * Returns the layer index at the specified position
+     *
+     * @param layer layer position
+     * @return layer index
+     * @throws unzip_exception if position is out of range
+     */
+    const file_index& get_layer(size_t layer) const;
+
+    /**
+     * Returns the number of entries in the merged list, shadowed entries
+     * and repeated directory entries are not counted
+     *
+     * @return number of merged entries
+     */
+    size_t get_entries_count() const;
+
+    /**
+     * Returns the merged entry with the specified id
+     *
+     * @param id overlay entry id
+     * @return resolved entry
+     * @throws unzip_exception if id is out of range
+     */
+    overlay_entry get_entry(uint32_t id) const;
+
+    /**
+     * Returns the name of the merged entry with the specified id
+     *
+     * @param id overlay entry id
+     * @return view over the entry name, valid while this index is alive
+     * @throws unzip_exception if id is out of range
+     */
+    sl::io::span<const char> get_entry_name(uint32_t id) const;
+
+    /**
+     * Returns ids of the merged entries with names starting with the specified prefix, sorted by name
+     *
+     * @param prefix names prefix, empty prefix matches all the entries
+     * @return view over the sorted overlay entry ids, valid while this index is alive
+     */
+    sl::io::span<const uint32_t> list_prefix(const std::string& prefix) const;
+
+    /**
+     * Returns names of the immediate children of the specified directory across
+     * all the layers sorted by name, subdirectories are returned with the trailing slash
+     *
+     * @param dir directory name with or without the trailing slash, empty for the root directory
+     * @return views over the children names, valid while this index is alive
+     */
+    std::vector<sl::io::span<const char>> list_directory(const std::string& dir) const;
+
+    /**
+     * Returns ids of the merged entries with names matching the specified
+     * glob pattern sorted by name, see "file_index::list_glob"
+     *
+     * @param pattern glob pattern
+     * @return sorted overlay entry ids
+     */
+    std::vector<uint32_t> list_glob(const std::string& pattern) const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_OVERLAY_INDEX_HPP */
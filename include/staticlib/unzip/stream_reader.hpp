@@ -0,0 +1,137 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   stream_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:10 AM
+ */
+
+#ifndef STATICLIB_UNZIP_STREAM_READER_HPP
+#define STATICLIB_UNZIP_STREAM_READER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+
+#include "staticlib/unzip/entry_codec.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * ZIP entry description read from the local file header
+ */
+struct stream_entry {
+    /**
+     * Entry name
+     */
+    std::string name;
+    /**
+     * Position of the local file header from the start of the stream
+     */
+    uint64_t offset = 0;
+    /**
+     * Compressed length, zero if deferred to the data descriptor
+     */
+    uint64_t comp_length = 0;
+    /**
+     * Uncompressed length, zero if deferred to the data descriptor
+     */
+    uint64_t uncomp_length = 0;
+    /**
+     * Compression method
+     */
+    uint16_t comp_method = 0;
+    /**
+     * General purpose bit flags
+     */
+    uint16_t flags = 0;
+    /**
+     * CRC-32 of the uncompressed data, zero if deferred to the data descriptor
+     */
+    uint32_t crc = 0;
+
+    /**
+     * Returns true if lengths and CRC-32 of this entry are written
+     * in the data descriptor after the entry data (bit 3 of the flags)
+     *
+     * @return true if entry data is followed by the data descriptor, false otherwise
+     */
+    bool has_data_descriptor() const {
+        return 0 != (flags & 8);
+    }
+};
+
+/**
+ * Options for the streaming reading of ZIP files
+ */
+struct stream_options {
+    /**
+     * Size of the read-ahead buffer, grows when a local header does not fit
+     */
+    size_t buffer_size = 64 << 10;
+
+    /**
+     * Whether to check CRC-32 of the entry data, lengths are always checked
+     */
+    bool verify_crc = false;
+};
+
+/**
+ * Reads the ZIP file from the forward-only source (pipe, socket) walking the local file
+ * headers in order, each entry is decompressed while it is read by the callback,
+ * unread entry data is skipped after the callback returns. Reading stops on the
+ * central directory, it is not read. Entries with data descriptors (bit 3 of
+ * the flags) are supported for all methods when lengths are also written
+ * in the local file header, otherwise deflated data is delimited by the end
+ * of the deflate stream and stored data - by the data descriptor with
+ * signature and lengths matching the preceding data.
+ *
+ * @param input source of the ZIP file data, reads are allowed to return
+ *        less data than requested, data after the central directory start
+ *        is not read
+ * @param callback function called with the entry description and the stream
+ *        of decompressed entry data, stream is only valid during the call
+ * @param options stream options
+ * @return number of entries read
+ * @throws unzip_exception on invalid or truncated ZIP data, on unsupported or encrypted entries,
+ *         on lengths or CRC-32 mismatch
+ */
+size_t read_zip_stream(codec_source& input, std::function<void(const stream_entry&, std::istream&)> callback,
+        stream_options options = stream_options());
+
+/**
+ * Reads the ZIP file from the specified forward-only input stream,
+ * see "read_zip_stream(codec_source&, ...)"
+ *
+ * @param input stream of the ZIP file data, for example "std::cin"
+ * @param callback function called with the entry description and the stream
+ *        of decompressed entry data, stream is only valid during the call
+ * @param options stream options
+ * @return number of entries read
+ * @throws unzip_exception on invalid or truncated ZIP data, on unsupported or encrypted entries,
+ *         on lengths or CRC-32 mismatch
+ */
+size_t read_zip_stream(std::istream& input, std::function<void(const stream_entry&, std::istream&)> callback,
+        stream_options options = stream_options());
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_STREAM_READER_HPP */
@@ -0,0 +1,433 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   archive_reader.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 10:24 AM
+ */
+
+#include "staticlib/unzip/archive_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+// http://stackoverflow.com/a/1904659/314015
+#define NOMINMAX
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include <windows.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+class file_reader : public archive_reader {
+    std::string zip_file_path;
+    uint64_t file_size = 0;
+#ifdef STATICLIB_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+#else // !STATICLIB_WINDOWS
+    int fd = -1;
+#endif // STATICLIB_WINDOWS
+
+public:
+    file_reader(const std::string& zip_file_path) :
+    zip_file_path(zip_file_path.data(), zip_file_path.length()) {
+        open_file();
+    }
+
+    file_reader(const file_reader&) = delete;
+
+    file_reader& operator=(const file_reader&) = delete;
+
+    ~file_reader() STATICLIB_NOEXCEPT {
+        close_file();
+    }
+
+    std::streamsize read_at(uint64_t position, sl::io::span<char> span) override {
+        if (position >= file_size) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = file_size - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        return read_file(position, span.data(), len);
+    }
+
+    uint64_t size() override {
+        return file_size;
+    }
+
+    const std::string& path() override {
+        return zip_file_path;
+    }
+
+#ifndef STATICLIB_WINDOWS
+    int file_descriptor() override {
+        return fd;
+    }
+#endif // !STATICLIB_WINDOWS
+
+private:
+#ifdef STATICLIB_WINDOWS
+    void open_file() {
+        auto wpath = sl::utils::widen(zip_file_path);
+        file = ::CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (INVALID_HANDLE_VALUE == file) throw unzip_exception(TRACEMSG(
+                "Error opening ZIP file: [" + zip_file_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        LARGE_INTEGER fsize;
+        if (0 == ::GetFileSizeEx(file, std::addressof(fsize))) {
+            auto err = ::GetLastError();
+            close_file();
+            throw unzip_exception(TRACEMSG(
+                    "Error getting size of ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+        file_size = static_cast<uint64_t>(fsize.QuadPart);
+    }
+
+    std::streamsize read_file(uint64_t position, char* buf, size_t len) {
+        // explicit offset makes the read independent from the shared file pointer
+        OVERLAPPED ov;
+        std::memset(std::addressof(ov), '\0', sizeof(ov));
+        ov.Offset = static_cast<DWORD>(position & 0xffffffff);
+        ov.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD to_read = len <= 0x40000000 ? static_cast<DWORD>(len) : 0x40000000;
+        DWORD read = 0;
+        if (0 == ::ReadFile(file, buf, to_read, std::addressof(read), std::addressof(ov))) {
+            auto err = ::GetLastError();
+            if (ERROR_HANDLE_EOF == err) {
+                return std::char_traits<char>::eof();
+            }
+            throw unzip_exception(TRACEMSG(
+                    "Error reading ZIP file: [" + zip_file_path + "]," +
+                    " position: [" + sl::support::to_string(position) + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+        return read > 0 ? static_cast<std::streamsize>(read) : std::char_traits<char>::eof();
+    }
+
+    void close_file() STATICLIB_NOEXCEPT {
+        if (INVALID_HANDLE_VALUE != file) {
+            ::CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+    }
+#else // !STATICLIB_WINDOWS
+    void open_file() {
+        fd = ::open(zip_file_path.c_str(), O_RDONLY);
+        if (-1 == fd) throw unzip_exception(TRACEMSG(
+                "Error opening ZIP file: [" + zip_file_path + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+        struct stat st;
+        if (-1 == ::fstat(fd, std::addressof(st))) {
+            auto err = errno;
+            close_file();
+            throw unzip_exception(TRACEMSG(
+                    "Error getting size of ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + ::strerror(err) + "]"));
+        }
+        file_size = static_cast<uint64_t>(st.st_size);
+    }
+
+    std::streamsize read_file(uint64_t position, char* buf, size_t len) {
+        for (;;) {
+            auto res = ::pread(fd, buf, len, static_cast<off_t>(position));
+            if (res > 0) {
+                return static_cast<std::streamsize>(res);
+            }
+            if (0 == res) {
+                return std::char_traits<char>::eof();
+            }
+            if (EINTR != errno) throw unzip_exception(TRACEMSG(
+                    "Error reading ZIP file: [" + zip_file_path + "]," +
+                    " position: [" + sl::support::to_string(position) + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+        }
+    }
+
+    void close_file() STATICLIB_NOEXCEPT {
+        if (-1 != fd) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif // STATICLIB_WINDOWS
+};
+
+class memory_reader : public archive_reader {
+    sl::io::span<const char> contents;
+    std::string name;
+    std::shared_ptr<const std::vector<char>> owned;
+
+public:
+    memory_reader(sl::io::span<const char> contents, std::string name,
+            std::shared_ptr<const std::vector<char>> owned = std::shared_ptr<const std::vector<char>>()) :
+    contents(contents),
+    name(std::move(name)),
+    owned(std::move(owned)) { }
+
+    std::streamsize read_at(uint64_t position, sl::io::span<char> span) override {
+        if (position >= contents.size()) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = contents.size() - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::memcpy(span.data(), contents.data() + position, len);
+        return static_cast<std::streamsize>(len);
+    }
+
+    uint64_t size() override {
+        return contents.size();
+    }
+
+    sl::io::span<const char> data() override {
+        return contents;
+    }
+
+    const std::string& path() override {
+        return name;
+    }
+};
+
+class range_reader : public archive_reader {
+    std::shared_ptr<archive_reader> parent;
+    uint64_t offset;
+    uint64_t length;
+    std::string name;
+
+public:
+    range_reader(std::shared_ptr<archive_reader> parent, uint64_t offset, uint64_t length, std::string name) :
+    parent(std::move(parent)),
+    offset(offset),
+    length(length),
+    name(std::move(name)) { }
+
+    std::streamsize read_at(uint64_t position, sl::io::span<char> span) override {
+        if (position >= length) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = length - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        return parent->read_at(offset + position, {span.data(), len});
+    }
+
+    uint64_t size() override {
+        return length;
+    }
+
+    sl::io::span<const char> data() override {
+        auto pdata = parent->data();
+        if (nullptr == pdata.data()) {
+            return pdata;
+        }
+        return sl::io::span<const char>(pdata.data() + offset, static_cast<size_t>(length));
+    }
+
+    const std::string& path() override {
+        return name;
+    }
+};
+
+class mapped_reader : public archive_reader {
+    std::string zip_file_path;
+    const char* mapping = nullptr;
+    uint64_t mapping_size = 0;
+#ifdef STATICLIB_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE file_mapping = NULL;
+#endif // STATICLIB_WINDOWS
+
+public:
+    mapped_reader(const std::string& zip_file_path) :
+    zip_file_path(zip_file_path.data(), zip_file_path.length()) {
+        map_file();
+    }
+
+    mapped_reader(const mapped_reader&) = delete;
+
+    mapped_reader& operator=(const mapped_reader&) = delete;
+
+    ~mapped_reader() STATICLIB_NOEXCEPT {
+        unmap_file();
+    }
+
+    std::streamsize read_at(uint64_t position, sl::io::span<char> span) override {
+        if (position >= mapping_size) {
+            return std::char_traits<char>::eof();
+        }
+        uint64_t avail = mapping_size - position;
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::memcpy(span.data(), mapping + position, len);
+        return static_cast<std::streamsize>(len);
+    }
+
+    uint64_t size() override {
+        return mapping_size;
+    }
+
+    sl::io::span<const char> data() override {
+        return sl::io::span<const char>(mapping, static_cast<size_t>(mapping_size));
+    }
+
+    const std::string& path() override {
+        return zip_file_path;
+    }
+
+private:
+#ifdef STATICLIB_WINDOWS
+    void map_file() {
+        auto wpath = sl::utils::widen(zip_file_path);
+        file = ::CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (INVALID_HANDLE_VALUE == file) throw unzip_exception(TRACEMSG(
+                "Error opening ZIP file: [" + zip_file_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        LARGE_INTEGER fsize;
+        if (0 == ::GetFileSizeEx(file, std::addressof(fsize))) {
+            auto err = ::GetLastError();
+            unmap_file();
+            throw unzip_exception(TRACEMSG(
+                    "Error getting size of ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+        mapping_size = static_cast<uint64_t>(fsize.QuadPart);
+        if (0 == mapping_size) {
+            return;
+        }
+        file_mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (NULL == file_mapping) {
+            auto err = ::GetLastError();
+            unmap_file();
+            throw unzip_exception(TRACEMSG(
+                    "Error mapping ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+        mapping = static_cast<const char*>(::MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (nullptr == mapping) {
+            auto err = ::GetLastError();
+            unmap_file();
+            throw unzip_exception(TRACEMSG(
+                    "Error mapping ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+    }
+
+    void unmap_file() STATICLIB_NOEXCEPT {
+        if (nullptr != mapping) {
+            ::UnmapViewOfFile(mapping);
+            mapping = nullptr;
+        }
+        if (NULL != file_mapping) {
+            ::CloseHandle(file_mapping);
+            file_mapping = NULL;
+        }
+        if (INVALID_HANDLE_VALUE != file) {
+            ::CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+    }
+#else // !STATICLIB_WINDOWS
+    void map_file() {
+        int fd = ::open(zip_file_path.c_str(), O_RDONLY);
+        if (-1 == fd) throw unzip_exception(TRACEMSG(
+                "Error opening ZIP file: [" + zip_file_path + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+        struct stat st;
+        if (-1 == ::fstat(fd, std::addressof(st))) {
+            auto err = errno;
+            ::close(fd);
+            throw unzip_exception(TRACEMSG(
+                    "Error getting size of ZIP file: [" + zip_file_path + "]," +
+                    " error: [" + ::strerror(err) + "]"));
+        }
+        mapping_size = static_cast<uint64_t>(st.st_size);
+        if (0 == mapping_size) {
+            ::close(fd);
+            return;
+        }
+        void* addr = ::mmap(nullptr, static_cast<size_t>(mapping_size), PROT_READ, MAP_SHARED, fd, 0);
+        auto err = errno;
+        // mapping stays valid after the descriptor is closed
+        ::close(fd);
+        if (MAP_FAILED == addr) throw unzip_exception(TRACEMSG(
+                "Error mapping ZIP file: [" + zip_file_path + "]," +
+                " error: [" + ::strerror(err) + "]"));
+        mapping = static_cast<const char*>(addr);
+    }
+
+    void unmap_file() STATICLIB_NOEXCEPT {
+        if (nullptr != mapping) {
+            ::munmap(const_cast<char*>(mapping), static_cast<size_t>(mapping_size));
+            mapping = nullptr;
+        }
+    }
+#endif // STATICLIB_WINDOWS
+};
+
+} // namespace
+
+std::shared_ptr<archive_reader> make_file_reader(const std::string& zip_file_path) {
+    return std::make_shared<file_reader>(zip_file_path);
+}
+
+std::shared_ptr<archive_reader> make_mapped_reader(const std::string& zip_file_path) {
+    return std::make_shared<mapped_reader>(zip_file_path);
+}
+
+std::shared_ptr<archive_reader> make_memory_reader(sl::io::span<const char> data, std::string name) {
+    return std::make_shared<memory_reader>(data, std::move(name));
+}
+
+std::shared_ptr<archive_reader> make_memory_reader(std::shared_ptr<const std::vector<char>> data,
+        std::string name) {
+    if (nullptr == data.get()) throw unzip_exception(TRACEMSG(
+            "Invalid null data specified for memory reader: [" + name + "]"));
+    auto contents = sl::io::span<const char>(data->data(), data->size());
+    return std::make_shared<memory_reader>(contents, std::move(name), std::move(data));
+}
+
+std::shared_ptr<archive_reader> make_range_reader(std::shared_ptr<archive_reader> parent, uint64_t offset,
+        uint64_t length, std::string name) {
+    if (nullptr == parent.get()) throw unzip_exception(TRACEMSG(
+            "Invalid null parent specified for range reader: [" + name + "]"));
+    uint64_t parent_size = parent->size();
+    if (offset > parent_size || length > parent_size - offset) throw unzip_exception(TRACEMSG(
+            "Invalid range: [" + name + "], offset: [" + sl::support::to_string(offset) + "]," +
+            " length: [" + sl::support::to_string(length) + "]," +
+            " parent size: [" + sl::support::to_string(parent_size) + "]"));
+    return std::make_shared<range_reader>(std::move(parent), offset, length, std::move(name));
+}
+
+} // namespace
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cd_parser.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:40 AM
+ */
+
+#include "cd_parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "run_workers.hpp"
+#include "zip_format.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const uint32_t zip_cd_start_signature = 0x02014b50;
+// smaller chunks balance the uneven lengths of records
+const size_t chunks_per_thread = 8;
+
+struct cd_chunk {
+    size_t pos;
+    uint32_t first_id;
+    uint32_t count;
+    size_t name_offset;
+
+    cd_chunk(size_t pos, uint32_t first_id, size_t name_offset) :
+    pos(pos),
+    first_id(first_id),
+    count(0),
+    name_offset(name_offset) { }
+};
+
+void decode_chunk(sl::io::span<const char> cd, const cd_chunk& chunk, const std::string& zip_file_path,
+        entry_record* records, char* arena, uint32_t* hashes) {
+    size_t pos = chunk.pos;
+    size_t name_offset = chunk.name_offset;
+    for (uint32_t i = 0; i < chunk.count; i++) {
+        const char* ptr = cd.data() + pos;
+        uint16_t namelen = load_16_le(ptr + 28);
+        uint16_t extralen = load_16_le(ptr + 30);
+        uint16_t commentlen = load_16_le(ptr + 32);
+        uint64_t comp_length = load_32_le(ptr + 20);
+        uint64_t uncomp_length = load_32_le(ptr + 24);
+        uint64_t offset = load_32_le(ptr + 42);
+        const char* name = ptr + cd_header_len;
+        if (zip64_marker_32 == uncomp_length || zip64_marker_32 == comp_length || zip64_marker_32 == offset) {
+            read_zip64_extra(name + namelen, extralen, false, uncomp_length, comp_length, offset);
+            if (zip64_marker_32 == uncomp_length || zip64_marker_32 == comp_length ||
+                    zip64_marker_32 == offset) throw unzip_exception(TRACEMSG(
+                    "Cannot find Zip64 extended information for entry: [" + std::string(name, namelen) + "]" +
+                    " in an alleged zip file: [" + zip_file_path + "]"));
+        }
+        entry_record& rec = records[chunk.first_id + i];
+        rec.offset = offset;
+        rec.comp_length = comp_length;
+        rec.uncomp_length = uncomp_length;
+        rec.name_offset = static_cast<uint32_t>(name_offset);
+        rec.name_len = namelen;
+        rec.comp_method = load_16_le(ptr + 10);
+        rec.crc = load_32_le(ptr + 16);
+        rec.reserved = 0;
+        if (namelen > 0) {
+            std::memcpy(arena + name_offset, name, namelen);
+        }
+        hashes[chunk.first_id + i] = entry_table::hash(name, namelen);
+        name_offset += namelen;
+        pos += cd_header_len + namelen + extralen + commentlen;
+    }
+}
+
+} // namespace
+
+uint64_t parse_cd_parallel(sl::io::span<const char> cd, uint64_t records_count, size_t threads_count,
+        const std::string& zip_file_path, entry_table& table) {
+    if (records_count >= static_cast<uint64_t>(std::numeric_limits<uint32_t>::max())) throw unzip_exception(TRACEMSG(
+            "Entries count limit exceeded: [" + sl::support::to_string(records_count) + "]," +
+            " in zip file: [" + zip_file_path + "]"));
+    // count is read from the end record, it must not be trusted for allocations
+    if (records_count > cd.size() / cd_header_len) throw unzip_exception(TRACEMSG(
+            "Unexpected end of Central Directory, records count: [" + sl::support::to_string(records_count) + "]," +
+            " length: [" + sl::support::to_string(cd.size()) + "]," +
+            " in an alleged zip file: [" + zip_file_path + "]"));
+    uint32_t count = static_cast<uint32_t>(records_count);
+    threads_count = std::max(static_cast<size_t>(1), threads_count);
+    size_t chunks_count = threads_count * chunks_per_thread;
+    uint32_t chunk_len = static_cast<uint32_t>(std::max(static_cast<size_t>(1),
+            (static_cast<size_t>(count) + chunks_count - 1) / chunks_count));
+
+    // record boundaries, only the length fields are read
+    std::vector<cd_chunk> chunks;
+    size_t pos = 0;
+    size_t arena_len = 0;
+    for (uint32_t id = 0; id < count; id++) {
+        if (0 == id % chunk_len) {
+            chunks.emplace_back(pos, id, arena_len);
+        }
+        if (cd_header_len > cd.size() - pos) throw unzip_exception(TRACEMSG(
+                "Unexpected end of Central Directory, record: [" + sl::support::to_string(id) + "]," +
+                " in an alleged zip file: [" + zip_file_path + "]"));
+        const char* ptr = cd.data() + pos;
+        uint32_t sig = load_32_le(ptr);
+        if (zip_cd_start_signature != sig) throw unzip_exception(TRACEMSG(
+                "Cannot find Central Directory file header" +
+                " in an alleged zip file: [" + zip_file_path + "]," +
+                " invalid signature: [" + sl::support::to_string(sig) + "]," +
+                " must be: [" + sl::support::to_string(zip_cd_start_signature) + "]"));
+        size_t namelen = load_16_le(ptr + 28);
+        size_t len = cd_header_len + namelen + load_16_le(ptr + 30) + load_16_le(ptr + 32);
+        if (len > cd.size() - pos) throw unzip_exception(TRACEMSG(
+                "Unexpected end of Central Directory, record: [" + sl::support::to_string(id) + "]," +
+                " in an alleged zip file: [" + zip_file_path + "]"));
+        arena_len += namelen;
+        pos += len;
+        chunks.back().count += 1;
+    }
+    if (arena_len > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) throw unzip_exception(TRACEMSG(
+            "Entry names total length limit exceeded: [" + sl::support::to_string(arena_len) + "]," +
+            " in zip file: [" + zip_file_path + "]"));
+
+    // chunks are decoded directly into the table storage
+    std::vector<entry_record> records;
+    records.resize(count);
+    std::vector<char> arena;
+    arena.resize(arena_len);
+    std::vector<uint32_t> hashes;
+    hashes.resize(count);
+    threads_count = std::min(threads_count, chunks.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex mtx;
+    std::string error;
+    auto worker = [&] {
+        while (!failed.load()) {
+            size_t i = next.fetch_add(1);
+            if (i >= chunks.size()) {
+                break;
+            }
+            try {
+                decode_chunk(cd, chunks[i], zip_file_path, records.data(), arena.data(), hashes.data());
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> guard{mtx};
+                if (!failed.load()) {
+                    error = e.what();
+                    failed.store(true);
+                }
+            }
+        }
+    };
+    run_workers(threads_count, worker);
+    if (failed.load()) throw unzip_exception(TRACEMSG(
+            "Error parsing Central Directory of zip file: [" + zip_file_path + "]" +
+            "\n" + error));
+
+    uint32_t duplicate = table.assign(std::move(records), std::move(arena), hashes);
+    if (entry_table::not_found != duplicate) throw unzip_exception(TRACEMSG(
+            "Invalid Duplicate entry: [" + std::string(table.name_data(duplicate), table.name_len(duplicate)) + "]" +
+            " in a zip file: [" + zip_file_path + "]"));
+    return static_cast<uint64_t>(pos);
+}
+
+} // namespace
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cd_parser.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:30 AM
+ */
+
+#ifndef STATICLIB_UNZIP_CD_PARSER_HPP
+#define STATICLIB_UNZIP_CD_PARSER_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "staticlib/io/span.hpp"
+
+#include "entry_table.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Parses the central directory held in memory on multiple threads:
+ * record boundaries are found with a single pass over the length fields,
+ * then chunks of records are decoded concurrently directly into the
+ * table storage, name hashes are computed by the decoding threads,
+ * only the final hash table insertion is sequential
+ *
+ * @param cd central directory contents, may be followed by other data
+ * @param records_count number of records
+ * @param threads_count number of threads
+ * @param zip_file_path path to the ZIP file, used for error reporting
+ * @param table empty table to fill
+ * @return number of central directory bytes parsed
+ * @throws unzip_exception on invalid or duplicate records
+ */
+uint64_t parse_cd_parallel(sl::io::span<const char> cd, uint64_t records_count, size_t threads_count,
+        const std::string& zip_file_path, entry_table& table);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_CD_PARSER_HPP */
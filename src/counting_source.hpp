@@ -0,0 +1,80 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   counting_source.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:50 AM
+ */
+
+#ifndef STATICLIB_UNZIP_COUNTING_SOURCE_HPP
+#define STATICLIB_UNZIP_COUNTING_SOURCE_HPP
+
+#include <cstdint>
+#include <ios>
+
+#include "staticlib/io/span.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Source wrapper that counts the number of bytes read through it,
+ * wrapped source is referenced and must outlive this wrapper
+ */
+template<typename Source>
+class counting_source {
+    Source& src;
+    uint64_t count = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src source to wrap
+     */
+    explicit counting_source(Source& src) :
+    src(src) { }
+
+    /**
+     * Reads data from the wrapped source
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of data
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        std::streamsize res = src.read(span);
+        if (res > 0) {
+            count += static_cast<uint64_t>(res);
+        }
+        return res;
+    }
+
+    /**
+     * Returns the number of bytes read
+     *
+     * @return number of bytes read
+     */
+    uint64_t get_count() const {
+        return count;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_COUNTING_SOURCE_HPP */
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   crc32.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 10:07 PM
+ */
+
+#include "crc32.hpp"
+
+#include <array>
+
+#include "staticlib/config.hpp"
+
+// carry-less multiplication is compiled with the function target attribute,
+// so the library does not require "-mpclmul" from the toolchain
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define STATICLIB_UNZIP_CRC32_PCLMUL
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif // __x86_64__
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const uint32_t crc32_polynomial = 0xedb88320;
+
+using crc32_tables = std::array<std::array<uint32_t, 256>, 16>;
+
+crc32_tables make_tables() {
+    crc32_tables res;
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0 != (crc & 1) ? crc32_polynomial : 0);
+        }
+        res[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (size_t t = 1; t < res.size(); t++) {
+            res[t][i] = (res[t - 1][i] >> 8) ^ res[0][res[t - 1][i] & 0xff];
+        }
+    }
+    return res;
+}
+
+const crc32_tables& tables() {
+    static const crc32_tables res = make_tables();
+    return res;
+}
+
+uint32_t load_le32(const unsigned char* p) {
+    // compiled into a single load on little-endian platforms
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t crc32_tables_update(uint32_t crc, const unsigned char* p, size_t len) {
+    const crc32_tables& t = tables();
+    uint32_t c = ~crc;
+    while (len >= 16) {
+        uint32_t w0 = c ^ load_le32(p);
+        uint32_t w1 = load_le32(p + 4);
+        uint32_t w2 = load_le32(p + 8);
+        uint32_t w3 = load_le32(p + 12);
+        c = t[15][w0 & 0xff] ^ t[14][(w0 >> 8) & 0xff] ^ t[13][(w0 >> 16) & 0xff] ^ t[12][w0 >> 24] ^
+                t[11][w1 & 0xff] ^ t[10][(w1 >> 8) & 0xff] ^ t[9][(w1 >> 16) & 0xff] ^ t[8][w1 >> 24] ^
+                t[7][w2 & 0xff] ^ t[6][(w2 >> 8) & 0xff] ^ t[5][(w2 >> 16) & 0xff] ^ t[4][w2 >> 24] ^
+                t[3][w3 & 0xff] ^ t[2][(w3 >> 8) & 0xff] ^ t[1][(w3 >> 16) & 0xff] ^ t[0][w3 >> 24];
+        p += 16;
+        len -= 16;
+    }
+    while (len > 0) {
+        c = (c >> 8) ^ t[0][(c ^ *p) & 0xff];
+        p += 1;
+        len -= 1;
+    }
+    return ~c;
+}
+
+#ifdef STATICLIB_UNZIP_CRC32_PCLMUL
+// folding constants for the bit-reflected polynomial from the Intel paper
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+alignas(16) const uint64_t pclmul_k1k2[] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+alignas(16) const uint64_t pclmul_k3k4[] = {0x01751997d0ULL, 0x00ccaa009eULL};
+alignas(16) const uint64_t pclmul_k5k0[] = {0x0163cd6124ULL, 0x0000000000ULL};
+alignas(16) const uint64_t pclmul_poly[] = {0x01db710641ULL, 0x01f7011641ULL};
+const size_t pclmul_min_len = 64;
+
+// length must be a multiple of 16 and not less than 64, CRC is not inverted
+__attribute__((target("pclmul,sse2")))
+uint32_t crc32_pclmul_fold(uint32_t crc, const unsigned char* buf, size_t len) {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+    x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00));
+    x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10));
+    x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20));
+    x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(pclmul_k1k2));
+    buf += 64;
+    len -= 64;
+    // four folds in parallel
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00));
+        y6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10));
+        y7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20));
+        y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        buf += 64;
+        len -= 64;
+    }
+    // fold into 128 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(pclmul_k3k4));
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+    while (len >= 16) {
+        x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+    // fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pclmul_k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(pclmul_poly));
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+
+bool pclmul_supported() {
+    static const bool res = 0 != __builtin_cpu_supports("pclmul");
+    return res;
+}
+#endif // STATICLIB_UNZIP_CRC32_PCLMUL
+
+} // namespace
+
+uint32_t crc32_update(uint32_t crc, const char* data, size_t len) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+#ifdef STATICLIB_UNZIP_CRC32_PCLMUL
+    if (len >= pclmul_min_len && pclmul_supported()) {
+        size_t chunk = len & ~static_cast<size_t>(15);
+        crc = ~crc32_pclmul_fold(~crc, p, chunk);
+        p += chunk;
+        len -= chunk;
+    }
+#endif // STATICLIB_UNZIP_CRC32_PCLMUL
+    return crc32_tables_update(crc, p, len);
+}
+
+} // namespace
+}
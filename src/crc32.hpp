@@ -0,0 +1,47 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   crc32.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 10:05 PM
+ */
+
+#ifndef STATICLIB_UNZIP_CRC32_HPP
+#define STATICLIB_UNZIP_CRC32_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Updates CRC-32 (ISO-HDLC polynomial, as used in ZIP) with the specified
+ * data, initial value is zero
+ *
+ * @param crc current CRC value
+ * @param data pointer to data
+ * @param len data length
+ * @return updated CRC value
+ */
+uint32_t crc32_update(uint32_t crc, const char* data, size_t len);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_CRC32_HPP */
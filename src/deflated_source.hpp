@@ -0,0 +1,150 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   deflated_source.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:20 AM
+ */
+
+#ifndef STATICLIB_UNZIP_DEFLATED_SOURCE_HPP
+#define STATICLIB_UNZIP_DEFLATED_SOURCE_HPP
+
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <utility>
+
+#include "staticlib/io.hpp"
+#include "staticlib/compress.hpp"
+
+#include "staticlib/unzip/entry_codec.hpp"
+#include "staticlib/unzip/entry_source.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Source over the deflated ZIP entry, inflates the data inline without
+ * the indirection of the public "entry_source" specialization,
+ * zlib headers are only included by the library sources
+ */
+template<typename Source>
+class deflated_source {
+    sl::compress::inflate_source<Source> inflater;
+    uint64_t avail;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src source over the compressed entry data
+     * @param uncomp_length uncompressed entry length
+     */
+    deflated_source(Source&& src, uint64_t uncomp_length) :
+    inflater(std::move(src)),
+    avail(uncomp_length) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    deflated_source(const deflated_source&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    deflated_source& operator=(const deflated_source&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    deflated_source(deflated_source&& other) :
+    inflater(std::move(other.inflater)),
+    avail(other.avail) {
+        other.avail = 0;
+    }
+
+    /**
+     * Reads and inflates entry data
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of entry
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        if (0 == avail) {
+            return std::char_traits<char>::eof();
+        }
+        size_t len = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        std::streamsize res = sl::io::read_all(inflater, {span.data(), len});
+        if (res <= 0) {
+            return std::char_traits<char>::eof();
+        }
+        avail -= static_cast<uint64_t>(res);
+        return res;
+    }
+};
+
+/**
+ * Source that owns the codec source, allows to use the codec
+ * sources with the "sl::io" templates
+ */
+class owned_source {
+    std::unique_ptr<codec_source> src;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src codec source to own
+     */
+    explicit owned_source(std::unique_ptr<codec_source>&& src) :
+    src(std::move(src)) { }
+
+    /**
+     * Reads data from the owned source
+     *
+     * @param span buffer to read data into
+     * @return number of bytes read, "std::char_traits<char>::eof()" on the end of data
+     */
+    std::streamsize read(sl::io::span<char> span) {
+        return src->read(span);
+    }
+};
+
+/**
+ * Entry source type used by the library internally, deflated entries
+ * are read with "deflated_source"
+ */
+template<typename Source, sl::compress::zip_compression_method Method>
+struct native_entry_source {
+    using type = entry_source<Source, Method>;
+};
+
+/**
+ * Entry source type used by the library internally for the deflated entries
+ */
+template<typename Source>
+struct native_entry_source<Source, sl::compress::zip_compression_method::deflate> {
+    using type = deflated_source<Source>;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_DEFLATED_SOURCE_HPP */
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_cache.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 9:14 PM
+ */
+
+#include "staticlib/unzip/entry_cache.hpp"
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "staticlib/pimpl/forward_macros.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const size_t max_shards_count = 16;
+
+using data_ptr = std::shared_ptr<const std::vector<char>>;
+
+struct cache_shard {
+    std::mutex mtx;
+    // most recently used entries are at front
+    std::list<std::pair<uint64_t, data_ptr>> lru;
+    std::unordered_map<uint64_t, std::list<std::pair<uint64_t, data_ptr>>::iterator> map;
+    size_t bytes_used = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+} // namespace
+
+class entry_cache::impl : public sl::pimpl::object::impl {
+    size_t shard_budget;
+    size_t entry_max_size;
+    std::vector<std::unique_ptr<cache_shard>> shards;
+
+public:
+    ~impl() STATICLIB_NOEXCEPT { };
+
+    impl(size_t budget, size_t entry_max_size) {
+        // fewer shards for small budgets, so the largest entry still fits into a shard
+        size_t count = 1;
+        while (count < max_shards_count && budget / (count * 2) >= entry_max_size) {
+            count *= 2;
+        }
+        this->shard_budget = budget / count;
+        this->entry_max_size = std::min(entry_max_size, shard_budget);
+        for (size_t i = 0; i < count; i++) {
+            shards.emplace_back(new cache_shard());
+        }
+    }
+
+    data_ptr get(entry_cache&, uint64_t key) {
+        cache_shard& sh = shard(key);
+        std::lock_guard<std::mutex> guard{sh.mtx};
+        auto it = sh.map.find(key);
+        if (sh.map.end() == it) {
+            sh.misses += 1;
+            return data_ptr();
+        }
+        sh.hits += 1;
+        sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+        return it->second->second;
+    }
+
+    data_ptr put(entry_cache&, uint64_t key, data_ptr data) {
+        if (nullptr == data.get() || data->size() > entry_max_size) {
+            return data;
+        }
+        cache_shard& sh = shard(key);
+        std::lock_guard<std::mutex> guard{sh.mtx};
+        auto existing = sh.map.find(key);
+        if (sh.map.end() != existing) {
+            return existing->second->second;
+        }
+        sh.lru.emplace_front(key, data);
+        sh.map.emplace(key, sh.lru.begin());
+        sh.bytes_used += data->size();
+        while (sh.bytes_used > shard_budget) {
+            auto& last = sh.lru.back();
+            sh.bytes_used -= last.second->size();
+            sh.map.erase(last.first);
+            sh.lru.pop_back();
+            sh.evictions += 1;
+        }
+        return data;
+    }
+
+    size_t get_entry_max_size(const entry_cache&) const {
+        return entry_max_size;
+    }
+
+    entry_cache_stats get_stats(const entry_cache&) const {
+        entry_cache_stats res;
+        for (auto& sh : shards) {
+            std::lock_guard<std::mutex> guard{sh->mtx};
+            res.hits += sh->hits;
+            res.misses += sh->misses;
+            res.evictions += sh->evictions;
+            res.entries_count += sh->map.size();
+            res.bytes_used += sh->bytes_used;
+        }
+        return res;
+    }
+
+    void clear(entry_cache&) {
+        for (auto& sh : shards) {
+            std::lock_guard<std::mutex> guard{sh->mtx};
+            sh->map.clear();
+            sh->lru.clear();
+            sh->bytes_used = 0;
+        }
+    }
+
+private:
+    cache_shard& shard(uint64_t key) {
+        // offsets are spread with the Fibonacci hashing
+        uint64_t h = key * 0x9e3779b97f4a7c15ULL;
+        return *shards[static_cast<size_t>(h >> 32) & (shards.size() - 1)];
+    }
+};
+PIMPL_FORWARD_CONSTRUCTOR(entry_cache, (size_t)(size_t), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_cache, std::shared_ptr<const std::vector<char>>, get, (uint64_t), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_cache, std::shared_ptr<const std::vector<char>>, put, (uint64_t)(std::shared_ptr<const std::vector<char>>), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_cache, size_t, get_entry_max_size, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_cache, entry_cache_stats, get_stats, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_cache, void, clear, (), (), unzip_exception)
+
+} // namespace
+}
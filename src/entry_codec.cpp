@@ -0,0 +1,114 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_codec.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 11:35 PM
+ */
+
+#include "staticlib/unzip/entry_codec.hpp"
+
+#include <map>
+#include <mutex>
+
+#include "staticlib/io.hpp"
+#include "staticlib/compress.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "deflated_source.hpp"
+#include "zstd_codec.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+class deflate_codec : public entry_codec {
+public:
+    std::string name() const override {
+        return "deflate";
+    }
+
+    std::unique_ptr<codec_source> open_decoder(std::unique_ptr<codec_source> compressed,
+            uint64_t uncomp_length) const override {
+        return make_codec_source(deflated_source<owned_source>(
+                owned_source(std::move(compressed)), uncomp_length));
+    }
+
+    void decode(sl::io::span<const char> in, sl::io::span<char> out) const override {
+        auto src = deflated_source<sl::io::array_source>(
+                sl::io::array_source(in.data(), in.size()), static_cast<uint64_t>(out.size()));
+        auto read = sl::io::read_all(src, out);
+        size_t len = read > 0 ? static_cast<size_t>(read) : 0;
+        if (out.size() != len) throw unzip_exception(TRACEMSG(
+                "Invalid length of inflated data, expected: [" + sl::support::to_string(out.size()) + "]," +
+                " actual: [" + sl::support::to_string(len) + "]"));
+    }
+};
+
+class codec_registry {
+    std::mutex mtx;
+    std::map<uint16_t, std::shared_ptr<const entry_codec>> codecs;
+
+public:
+    codec_registry() {
+        codecs.emplace(static_cast<uint16_t>(sl::compress::zip_compression_method::deflate),
+                std::make_shared<deflate_codec>());
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+        codecs.emplace(zstd_method, make_zstd_codec());
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+    }
+
+    void put(uint16_t comp_method, std::shared_ptr<const entry_codec> codec) {
+        std::lock_guard<std::mutex> guard{mtx};
+        codecs[comp_method] = std::move(codec);
+    }
+
+    std::shared_ptr<const entry_codec> get(uint16_t comp_method) {
+        std::lock_guard<std::mutex> guard{mtx};
+        auto it = codecs.find(comp_method);
+        return codecs.end() != it ? it->second : std::shared_ptr<const entry_codec>();
+    }
+};
+
+codec_registry& static_registry() {
+    static codec_registry registry;
+    return registry;
+}
+
+} // namespace
+
+void register_codec(uint16_t comp_method, std::shared_ptr<const entry_codec> codec) {
+    if (static_cast<uint16_t>(sl::compress::zip_compression_method::store) == comp_method ||
+            static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) == comp_method) {
+        throw unzip_exception(TRACEMSG(
+                "Cannot replace native compression method: [" + sl::support::to_string(comp_method) + "]"));
+    }
+    if (nullptr == codec.get()) throw unzip_exception(TRACEMSG(
+            "Null codec specified for compression method: [" + sl::support::to_string(comp_method) + "]"));
+    static_registry().put(comp_method, std::move(codec));
+}
+
+std::shared_ptr<const entry_codec> find_codec(uint16_t comp_method) {
+    return static_registry().get(comp_method);
+}
+
+} // namespace
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_inflater.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:25 AM
+ */
+
+#include "staticlib/unzip/entry_source.hpp"
+
+#include "staticlib/pimpl/forward_macros.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "deflated_source.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+class entry_inflater::impl : public sl::pimpl::object::impl {
+    deflated_source<owned_source> src;
+
+public:
+    ~impl() STATICLIB_NOEXCEPT { };
+
+    impl(std::unique_ptr<codec_source>&& compressed, uint64_t uncomp_length) :
+    src(owned_source(std::move(compressed)), uncomp_length) { }
+
+    std::streamsize read(entry_inflater&, sl::io::span<char> span) {
+        return src.read(span);
+    }
+};
+
+// compressed source is moved into the impl, forwarding constructor would pass it as lvalue
+entry_inflater::entry_inflater(std::unique_ptr<codec_source> compressed, uint64_t uncomp_length) :
+sl::pimpl::object(nullptr, std::unique_ptr<sl::pimpl::object::impl>(
+        new entry_inflater::impl(std::move(compressed), uncomp_length))) { }
+
+PIMPL_FORWARD_METHOD(entry_inflater, std::streamsize, read, (sl::io::span<char>), (), unzip_exception)
+
+} // namespace
+}
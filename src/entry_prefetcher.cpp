@@ -0,0 +1,279 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_prefetcher.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 8:42 PM
+ */
+
+#include "staticlib/unzip/entry_prefetcher.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "staticlib/pimpl/forward_macros.hpp"
+
+#include "staticlib/unzip/operations.hpp"
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+using data_ptr = std::shared_ptr<const std::vector<char>>;
+
+struct prefetch_hint {
+    std::string name;
+    size_t length;
+
+    prefetch_hint(std::string name, size_t length) :
+    name(std::move(name)),
+    length(length) { }
+};
+
+struct prefetch_slot {
+    size_t length = 0;
+    bool ready = false;
+    data_ptr data;
+};
+
+} // namespace
+
+class entry_prefetcher::impl : public sl::pimpl::object::impl {
+    const file_index& idx;
+    size_t budget;
+
+    mutable std::mutex mtx;
+    std::condition_variable work_cv;
+    std::condition_variable ready_cv;
+    std::vector<prefetch_hint> hints;
+    std::unordered_map<std::string, size_t> positions;
+    // next hint to start, hints before "consumed_pos" are dropped
+    size_t next_pos = 0;
+    size_t consumed_pos = 0;
+    // started entries of the current generation, keyed by hint position
+    std::map<size_t, prefetch_slot> slots;
+    uint64_t generation = 0;
+    size_t bytes_buffered = 0;
+    bool stopped = false;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t wasted = 0;
+
+    std::vector<std::thread> threads;
+
+public:
+    ~impl() STATICLIB_NOEXCEPT {
+        stop();
+    }
+
+    impl(const file_index& idx, prefetch_options options) :
+    idx(idx),
+    budget(options.buffer_budget) {
+        size_t count = std::max(options.threads_count, static_cast<size_t>(1));
+        try {
+            for (size_t i = 0; i < count; i++) {
+                threads.emplace_back([this] {
+                    run_worker();
+                });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    void hint(entry_prefetcher&, const std::vector<std::string>& entry_names) {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            reset();
+            for (auto& name : entry_names) {
+                if (positions.end() != positions.find(name)) {
+                    continue;
+                }
+                auto desc = idx.find_zip_entry(name);
+                if (-1 == desc.offset) {
+                    continue;
+                }
+                positions.emplace(name, hints.size());
+                hints.emplace_back(name, static_cast<size_t>(desc.uncomp_length));
+            }
+        }
+        work_cv.notify_all();
+        ready_cv.notify_all();
+    }
+
+    void cancel(entry_prefetcher&) {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            reset();
+        }
+        ready_cv.notify_all();
+    }
+
+    data_ptr take(entry_prefetcher&, const std::string& entry_name) {
+        std::unique_lock<std::mutex> lock{mtx};
+        auto it = positions.find(entry_name);
+        if (positions.end() == it || it->second < consumed_pos) {
+            misses += 1;
+            return data_ptr();
+        }
+        size_t pos = it->second;
+        // skipped entries are not expected to be read anymore
+        drop_before(pos);
+        consumed_pos = pos + 1;
+        work_cv.notify_all();
+        if (next_pos <= pos) {
+            next_pos = pos + 1;
+            misses += 1;
+            return data_ptr();
+        }
+        uint64_t gen = generation;
+        ready_cv.wait(lock, [this, gen, pos] {
+            auto slot = slots.find(pos);
+            return gen != generation || slots.end() == slot || slot->second.ready;
+        });
+        auto slot = slots.find(pos);
+        if (gen != generation || slots.end() == slot) {
+            misses += 1;
+            return data_ptr();
+        }
+        data_ptr res = std::move(slot->second.data);
+        bytes_buffered -= slot->second.length;
+        slots.erase(slot);
+        hits += 1;
+        work_cv.notify_all();
+        return res;
+    }
+
+    const file_index& get_index(const entry_prefetcher&) const {
+        return idx;
+    }
+
+    prefetch_stats get_stats(const entry_prefetcher&) const {
+        std::lock_guard<std::mutex> guard{mtx};
+        prefetch_stats res;
+        res.hits = hits;
+        res.misses = misses;
+        res.wasted = wasted;
+        res.bytes_buffered = bytes_buffered;
+        return res;
+    }
+
+private:
+    void run_worker() {
+        std::unique_lock<std::mutex> lock{mtx};
+        for (;;) {
+            work_cv.wait(lock, [this] {
+                return stopped || can_start();
+            });
+            if (stopped) {
+                return;
+            }
+            size_t pos = next_pos;
+            next_pos += 1;
+            std::string name = hints[pos].name;
+            size_t length = hints[pos].length;
+            uint64_t gen = generation;
+            // space is reserved before decompression, so the budget is never exceeded
+            bytes_buffered += length;
+            slots[pos].length = length;
+            lock.unlock();
+            data_ptr data;
+            try {
+                data = std::make_shared<std::vector<char>>(read_entry(idx, name));
+            } catch (const std::exception&) {
+                // entry is read again by the consumer, that reports the error
+            }
+            lock.lock();
+            auto slot = slots.find(pos);
+            if (gen != generation || slots.end() == slot || nullptr == data.get()) {
+                bytes_buffered -= length;
+                if (gen == generation && slots.end() != slot) {
+                    slots.erase(slot);
+                }
+                if (nullptr != data.get()) {
+                    wasted += 1;
+                }
+                work_cv.notify_all();
+            } else {
+                slot->second.ready = true;
+                slot->second.data = std::move(data);
+            }
+            ready_cv.notify_all();
+        }
+    }
+
+    bool can_start() {
+        while (next_pos < hints.size() && hints[next_pos].length > budget) {
+            next_pos += 1;
+        }
+        return next_pos < hints.size() && bytes_buffered + hints[next_pos].length <= budget;
+    }
+
+    void drop_before(size_t pos) {
+        auto end = slots.lower_bound(pos);
+        for (auto it = slots.begin(); it != end;) {
+            if (it->second.ready) {
+                bytes_buffered -= it->second.length;
+                wasted += 1;
+            }
+            // entries being decompressed are released by their workers
+            it = slots.erase(it);
+        }
+    }
+
+    void reset() {
+        drop_before(hints.size());
+        hints.clear();
+        positions.clear();
+        next_pos = 0;
+        consumed_pos = 0;
+        generation += 1;
+    }
+
+    void stop() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            stopped = true;
+            generation += 1;
+        }
+        work_cv.notify_all();
+        ready_cv.notify_all();
+        for (auto& th : threads) {
+            if (th.joinable()) {
+                th.join();
+            }
+        }
+    }
+};
+PIMPL_FORWARD_CONSTRUCTOR(entry_prefetcher, (const file_index&)(prefetch_options), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_prefetcher, void, hint, (const std::vector<std::string>&), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_prefetcher, void, cancel, (), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_prefetcher, std::shared_ptr<const std::vector<char>>, take, (const std::string&), (), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_prefetcher, const file_index&, get_index, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(entry_prefetcher, prefetch_stats, get_stats, (), (const), unzip_exception)
+
+} // namespace
+}
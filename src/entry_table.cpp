@@ -0,0 +1,244 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_table.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 4:41 PM
+ */
+
+#include "entry_table.hpp"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const size_t min_slots_count = 16;
+
+size_t slots_count_for(size_t count) {
+    // load factor is kept below 1/2
+    size_t res = min_slots_count;
+    while (res < count * 2) {
+        res <<= 1;
+    }
+    return res;
+}
+
+} // namespace
+
+const uint32_t entry_table::not_found;
+
+void entry_table::reserve(size_t count, size_t arena_len) {
+    records.reserve(count);
+    arena.reserve(arena_len);
+    size_t slots_count = slots_count_for(count);
+    if (slots_count > slots.size()) {
+        rehash(slots_count);
+    }
+    update_views();
+}
+
+uint32_t entry_table::add(const char* name, size_t name_len, const file_entry& entry) {
+    if (nullptr != external.get()) throw unzip_exception(TRACEMSG(
+            "Cannot add entry: [" + std::string(name, name_len) + "] to the read-only table"));
+    if (records.size() >= static_cast<size_t>(std::numeric_limits<uint32_t>::max())) throw unzip_exception(TRACEMSG(
+            "Entries count limit exceeded: [" + sl::support::to_string(records.size()) + "]"));
+    if (arena.size() + name_len > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) throw unzip_exception(TRACEMSG(
+            "Entry names total length limit exceeded: [" + sl::support::to_string(arena.size() + name_len) + "]"));
+    uint32_t id = static_cast<uint32_t>(records.size());
+    entry_record rec;
+    rec.offset = static_cast<uint64_t>(entry.offset);
+    rec.comp_length = static_cast<uint64_t>(entry.comp_length);
+    rec.uncomp_length = static_cast<uint64_t>(entry.uncomp_length);
+    rec.name_offset = static_cast<uint32_t>(arena.size());
+    rec.name_len = static_cast<uint16_t>(name_len);
+    rec.comp_method = entry.comp_method;
+    rec.crc = entry.crc;
+    rec.reserved = 0;
+    arena.insert(arena.end(), name, name + name_len);
+    records.push_back(rec);
+    bool is_file = name_len > 0 && '/' != name[name_len - 1];
+    if (!is_file) {
+        update_views();
+        return id;
+    }
+    if ((hashed_count + 1) * 2 > slots.size()) {
+        rehash(slots_count_for(hashed_count + 1));
+    }
+    uint32_t existing = insert(id, hash(name, name_len));
+    if (not_found != existing) {
+        // duplicate is not kept
+        records.pop_back();
+        arena.resize(rec.name_offset);
+        update_views();
+        return existing;
+    }
+    hashed_count += 1;
+    update_views();
+    return id;
+}
+
+uint32_t entry_table::assign(std::vector<entry_record>&& records, std::vector<char>&& arena,
+        const std::vector<uint32_t>& hashes) {
+    if (nullptr != external.get()) throw unzip_exception(TRACEMSG(
+            "Cannot assign records to the read-only table"));
+    this->records = std::move(records);
+    this->arena = std::move(arena);
+    size_t files_count = 0;
+    for (const entry_record& rec : this->records) {
+        if (rec.name_len > 0 && '/' != this->arena[rec.name_offset + rec.name_len - 1]) {
+            files_count += 1;
+        }
+    }
+    slots.assign(slots_count_for(files_count), entry_slot());
+    hashed_count = 0;
+    uint32_t res = not_found;
+    for (uint32_t id = 0; id < this->records.size(); id++) {
+        const entry_record& rec = this->records[id];
+        bool is_file = rec.name_len > 0 && '/' != this->arena[rec.name_offset + rec.name_len - 1];
+        if (is_file) {
+            if (not_found != insert(id, hashes[id])) {
+                res = id;
+                break;
+            }
+            hashed_count += 1;
+        }
+    }
+    update_views();
+    return res;
+}
+
+uint32_t entry_table::find(const char* name, size_t name_len) const {
+    if (0 == slots_count) {
+        return not_found;
+    }
+    uint32_t h = hash(name, name_len);
+    size_t mask = slots_count - 1;
+    // probes are bounded, slots attached from the cache file may have no empty slot
+    for (size_t i = h & mask, probes = 0; probes < slots_count; i = (i + 1) & mask, probes++) {
+        const entry_slot& slot = slots_view[i];
+        if (0 == slot.id_plus_one) {
+            return not_found;
+        }
+        if (h == slot.hash) {
+            uint32_t id = slot.id_plus_one - 1;
+            if (id >= records_count) {
+                throw_invalid_record(id);
+            }
+            if (name_len == records_view[id].name_len && 0 == std::memcmp(name, name_data(id), name_len)) {
+                return id;
+            }
+        }
+    }
+    return not_found;
+}
+
+void entry_table::attach(std::shared_ptr<archive_reader> holder, const entry_record* records_ptr, size_t records_count,
+        const entry_slot* slots_ptr, size_t slots_count, const char* arena_ptr, size_t arena_len, size_t hashed) {
+    std::vector<entry_record>().swap(this->records);
+    std::vector<entry_slot>().swap(this->slots);
+    std::vector<char>().swap(this->arena);
+    this->external = std::move(holder);
+    this->records_view = records_ptr;
+    this->records_count = records_count;
+    this->slots_view = slots_ptr;
+    this->slots_count = slots_count;
+    this->arena_view = arena_ptr;
+    this->arena_len = arena_len;
+    this->hashed_count = hashed;
+}
+
+void entry_table::throw_invalid_record(uint32_t id) const {
+    throw unzip_exception(TRACEMSG(
+            "Invalid index record, id: [" + sl::support::to_string(id) + "]," +
+            " records count: [" + sl::support::to_string(records_count) + "]," +
+            " names length: [" + sl::support::to_string(arena_len) + "]"));
+}
+
+size_t entry_table::memory_usage() const {
+    return records.capacity() * sizeof(entry_record) +
+            slots.capacity() * sizeof(entry_slot) +
+            arena.capacity();
+}
+
+uint32_t entry_table::hash(const char* name, size_t name_len) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < name_len; i++) {
+        h ^= static_cast<unsigned char>(name[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+uint32_t entry_table::insert(uint32_t id, uint32_t hash) {
+    size_t mask = slots.size() - 1;
+    const entry_record& rec = records[id];
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        entry_slot& slot = slots[i];
+        if (0 == slot.id_plus_one) {
+            slot.hash = hash;
+            slot.id_plus_one = id + 1;
+            return not_found;
+        }
+        if (hash == slot.hash) {
+            uint32_t other = slot.id_plus_one - 1;
+            const entry_record& other_rec = records[other];
+            if (rec.name_len == other_rec.name_len && 0 == std::memcmp(arena.data() + rec.name_offset,
+                    arena.data() + other_rec.name_offset, rec.name_len)) {
+                return other;
+            }
+        }
+    }
+}
+
+void entry_table::rehash(size_t slots_count) {
+    std::vector<entry_slot> old;
+    old.swap(slots);
+    slots.resize(slots_count);
+    size_t mask = slots.size() - 1;
+    for (const entry_slot& slot : old) {
+        if (0 != slot.id_plus_one) {
+            size_t i = slot.hash & mask;
+            while (0 != slots[i].id_plus_one) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        }
+    }
+}
+
+void entry_table::update_views() {
+    records_view = records.data();
+    records_count = records.size();
+    slots_view = slots.data();
+    slots_count = slots.size();
+    arena_view = arena.data();
+    arena_len = arena.size();
+}
+
+} // namespace
+}
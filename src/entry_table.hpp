@@ -0,0 +1,279 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_table.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 4:20 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ENTRY_TABLE_HPP
+#define STATICLIB_UNZIP_ENTRY_TABLE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/unzip/archive_reader.hpp"
+#include "staticlib/unzip/file_index.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Packed central directory record, name is stored in the names arena
+ */
+struct entry_record {
+    uint64_t offset;
+    uint64_t comp_length;
+    uint64_t uncomp_length;
+    uint32_t name_offset;
+    uint16_t name_len;
+    uint16_t comp_method;
+    uint32_t crc;
+    // keeps records 8-byte aligned without uninitialized padding in cache files
+    uint32_t reserved;
+};
+
+/**
+ * Open addressing hash table slot, empty slots have zero "id_plus_one"
+ */
+struct entry_slot {
+    uint32_t hash;
+    uint32_t id_plus_one;
+};
+
+/**
+ * Flat index over the central directory: records in the CD order, a single
+ * contiguous arena for all the names and a linear probing hash table
+ * with record ids, only file entries (not directories) are hashed.
+ * Table can either own its storage or be attached to the external
+ * read-only memory (memory-mapped index cache file).
+ */
+class entry_table {
+    std::vector<entry_record> records;
+    std::vector<entry_slot> slots;
+    std::vector<char> arena;
+    size_t hashed_count = 0;
+
+    // views used for lookups, point either to own storage or to external memory
+    const entry_record* records_view = nullptr;
+    size_t records_count = 0;
+    const entry_slot* slots_view = nullptr;
+    size_t slots_count = 0;
+    const char* arena_view = nullptr;
+    size_t arena_len = 0;
+    std::shared_ptr<archive_reader> external;
+
+public:
+    /**
+     * Reserves memory for the specified number of records
+     *
+     * @param count expected number of records
+     * @param arena_len expected total length of names
+     */
+    void reserve(size_t count, size_t arena_len);
+
+    /**
+     * Appends a record, file entries are also added to the hash table
+     *
+     * @param name pointer to entry name
+     * @param name_len entry name length
+     * @param entry entry description
+     * @return id of the appended record, or id of the existing record with
+     *         the same name if a duplicate file entry was specified
+     */
+    uint32_t add(const char* name, size_t name_len, const file_entry& entry);
+
+    /**
+     * Replaces contents of this table with the records decoded in bulk,
+     * file entries are added to the hash table using the precomputed hashes
+     *
+     * @param records records with names offsets pointing into the arena
+     * @param arena names of all the records
+     * @param hashes name hashes for all the records
+     * @return id of the first duplicate file entry, "not_found" if there are no duplicates
+     */
+    uint32_t assign(std::vector<entry_record>&& records, std::vector<char>&& arena,
+            const std::vector<uint32_t>& hashes);
+
+    /**
+     * Finds the id of the file entry with the specified name
+     *
+     * @param name pointer to entry name
+     * @param name_len entry name length
+     * @return entry id, "not_found" if there is no such entry
+     */
+    uint32_t find(const char* name, size_t name_len) const;
+
+    /**
+     * Number of records
+     *
+     * @return number of records
+     */
+    size_t size() const {
+        return records_count;
+    }
+
+    /**
+     * Returns pointer to the name of the specified record
+     *
+     * @param id record id
+     * @return pointer to the name, not null-terminated
+     */
+    const char* name_data(uint32_t id) const {
+        const entry_record& rec = records_view[id];
+        if (static_cast<size_t>(rec.name_offset) + rec.name_len > arena_len) {
+            throw_invalid_record(id);
+        }
+        return arena_view + rec.name_offset;
+    }
+
+    /**
+     * Returns name length of the specified record
+     *
+     * @param id record id
+     * @return name length
+     */
+    size_t name_len(uint32_t id) const {
+        return records_view[id].name_len;
+    }
+
+    /**
+     * Returns entry description for the specified record
+     *
+     * @param id record id
+     * @return entry description
+     */
+    file_entry entry(uint32_t id) const {
+        const entry_record& rec = records_view[id];
+        const uint64_t max_value = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        if (rec.offset > max_value || rec.comp_length > max_value || rec.uncomp_length > max_value) {
+            throw_invalid_record(id);
+        }
+        return file_entry(static_cast<int64_t>(rec.offset), static_cast<int64_t>(rec.comp_length),
+                static_cast<int64_t>(rec.uncomp_length), rec.comp_method, rec.crc);
+    }
+
+    /**
+     * Attaches this table to the external memory, memory contents
+     * are not copied and must stay valid while holder is alive.
+     * Records and slots are not scanned here, they are checked on access.
+     *
+     * @param holder owner of the external memory
+     * @param records_ptr pointer to records
+     * @param records_count number of records
+     * @param slots_ptr pointer to hash table slots
+     * @param slots_count number of slots, power of two
+     * @param arena_ptr pointer to names arena
+     * @param arena_len names arena length
+     * @param hashed number of hashed records
+     */
+    void attach(std::shared_ptr<archive_reader> holder, const entry_record* records_ptr, size_t records_count,
+            const entry_slot* slots_ptr, size_t slots_count, const char* arena_ptr, size_t arena_len, size_t hashed);
+
+    /**
+     * Returns view over the records
+     *
+     * @return pointer to records
+     */
+    const entry_record* records_data() const {
+        return records_view;
+    }
+
+    /**
+     * Returns view over the hash table slots
+     *
+     * @return pointer to slots
+     */
+    const entry_slot* slots_data() const {
+        return slots_view;
+    }
+
+    /**
+     * Returns number of hash table slots
+     *
+     * @return number of slots
+     */
+    size_t slots_size() const {
+        return slots_count;
+    }
+
+    /**
+     * Returns view over the names arena
+     *
+     * @return pointer to names arena
+     */
+    const char* arena_data() const {
+        return arena_view;
+    }
+
+    /**
+     * Returns names arena length
+     *
+     * @return names arena length
+     */
+    size_t arena_size() const {
+        return arena_len;
+    }
+
+    /**
+     * Returns number of hashed (file) records
+     *
+     * @return number of hashed records
+     */
+    size_t hashed_size() const {
+        return hashed_count;
+    }
+
+    /**
+     * Approximate number of bytes used by this table
+     *
+     * @return memory used in bytes
+     */
+    size_t memory_usage() const;
+
+    /**
+     * Record id returned when the entry is not found
+     */
+    static const uint32_t not_found = invalid_entry_id;
+
+    /**
+     * Hash function used for the entry names
+     *
+     * @param name pointer to entry name
+     * @param name_len entry name length
+     * @return name hash
+     */
+    static uint32_t hash(const char* name, size_t name_len);
+
+private:
+    void throw_invalid_record(uint32_t id) const;
+
+    uint32_t insert(uint32_t id, uint32_t hash);
+
+    void rehash(size_t slots_count);
+
+    void update_views();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ENTRY_TABLE_HPP */
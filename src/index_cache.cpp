@@ -0,0 +1,214 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   index_cache.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:17 AM
+ */
+
+#include "index_cache.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+// http://stackoverflow.com/a/1904659/314015
+#define NOMINMAX
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include <windows.h>
+#else // !STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const char cache_magic[8] = {'S', 'L', 'U', 'Z', 'I', 'D', 'X', '\0'};
+const uint32_t cache_version = 2;
+// cache files are not portable between platforms with different byte order
+const uint32_t cache_byte_order = 0x01020304;
+
+struct index_cache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t archive_size;
+    int64_t archive_mtime;
+    uint64_t cd_offset;
+    uint64_t records_count;
+    uint32_t tail_crc;
+    uint32_t record_size;
+    uint64_t table_records;
+    uint64_t table_slots;
+    uint64_t table_arena;
+    uint64_t table_hashed;
+};
+
+static_assert(0 == sizeof(index_cache_header) % 8, "Invalid index cache header alignment");
+static_assert(0 == sizeof(entry_record) % 8, "Invalid entry record alignment");
+
+uint64_t process_id() {
+#ifdef STATICLIB_WINDOWS
+    return static_cast<uint64_t>(::GetCurrentProcessId());
+#else // !STATICLIB_WINDOWS
+    return static_cast<uint64_t>(::getpid());
+#endif // STATICLIB_WINDOWS
+}
+
+void replace_file(const std::string& from, const std::string& to) {
+#ifdef STATICLIB_WINDOWS
+    auto wfrom = sl::utils::widen(from);
+    auto wto = sl::utils::widen(to);
+    if (0 == ::MoveFileExW(wfrom.c_str(), wto.c_str(), MOVEFILE_REPLACE_EXISTING)) throw unzip_exception(TRACEMSG(
+            "Error renaming file: [" + from + "] to: [" + to + "]," +
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+#else // !STATICLIB_WINDOWS
+    if (0 != std::rename(from.c_str(), to.c_str())) throw unzip_exception(TRACEMSG(
+            "Error renaming file: [" + from + "] to: [" + to + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+
+int64_t file_modified_time(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(path);
+    WIN32_FILE_ATTRIBUTE_DATA attrs;
+    if (0 == ::GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, std::addressof(attrs))) {
+        return 0;
+    }
+    uint64_t ticks = (static_cast<uint64_t>(attrs.ftLastWriteTime.dwHighDateTime) << 32) |
+            attrs.ftLastWriteTime.dwLowDateTime;
+    // 100ns intervals since 1601
+    return static_cast<int64_t>(ticks / 10000000) - 11644473600LL;
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    if (0 != ::stat(path.c_str(), std::addressof(st))) {
+        return 0;
+    }
+    return static_cast<int64_t>(st.st_mtime);
+#endif // STATICLIB_WINDOWS
+}
+
+bool load_index_cache(const std::string& cache_path, const index_cache_key& key, entry_table& table) {
+    std::shared_ptr<archive_reader> mapping;
+    try {
+        mapping = make_mapped_reader(cache_path);
+    } catch (const std::exception&) {
+        return false;
+    }
+    auto data = mapping->data();
+    index_cache_header header;
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(std::addressof(header), data.data(), sizeof(header));
+    bool valid = 0 == std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) &&
+            cache_version == header.version &&
+            cache_byte_order == header.byte_order &&
+            sizeof(entry_record) == header.record_size &&
+            key.archive_size == header.archive_size &&
+            key.archive_mtime == header.archive_mtime &&
+            key.cd_offset == header.cd_offset &&
+            key.records_count == header.records_count &&
+            key.tail_crc == header.tail_crc;
+    if (!valid) {
+        return false;
+    }
+    // counts are checked before multiplication, so section lengths cannot overflow
+    uint64_t avail = data.size() - sizeof(header);
+    if (header.table_records > avail / sizeof(entry_record) ||
+            header.table_records > std::numeric_limits<uint32_t>::max() ||
+            header.table_slots > avail / sizeof(entry_slot) ||
+            header.table_arena > avail ||
+            header.table_hashed > header.table_records) {
+        return false;
+    }
+    // slots need a power of two count for masking and at least one empty slot to stop probing,
+    // records and slots contents are checked on lookups, not scanned here
+    if (0 == header.table_slots ? 0 != header.table_hashed :
+            0 != (header.table_slots & (header.table_slots - 1)) || header.table_hashed >= header.table_slots) {
+        return false;
+    }
+    uint64_t records_len = header.table_records * sizeof(entry_record);
+    uint64_t slots_len = header.table_slots * sizeof(entry_slot);
+    if (records_len + slots_len + header.table_arena != avail) {
+        return false;
+    }
+    const char* records_ptr = data.data() + sizeof(header);
+    const char* slots_ptr = records_ptr + records_len;
+    const char* arena_ptr = slots_ptr + slots_len;
+    // mapping is page-aligned, header and records sizes are multiples of 8
+    table.attach(std::move(mapping),
+            reinterpret_cast<const entry_record*>(records_ptr), static_cast<size_t>(header.table_records),
+            reinterpret_cast<const entry_slot*>(slots_ptr), static_cast<size_t>(header.table_slots),
+            arena_ptr, static_cast<size_t>(header.table_arena), static_cast<size_t>(header.table_hashed));
+    return true;
+}
+
+void save_index_cache(const std::string& cache_path, const index_cache_key& key, const entry_table& table) {
+    index_cache_header header;
+    std::memset(std::addressof(header), '\0', sizeof(header));
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = cache_version;
+    header.byte_order = cache_byte_order;
+    header.archive_size = key.archive_size;
+    header.archive_mtime = key.archive_mtime;
+    header.cd_offset = key.cd_offset;
+    header.records_count = key.records_count;
+    header.tail_crc = key.tail_crc;
+    header.record_size = sizeof(entry_record);
+    header.table_records = table.size();
+    header.table_slots = table.slots_size();
+    header.table_arena = table.arena_size();
+    header.table_hashed = table.hashed_size();
+    auto tmp_path = cache_path + ".tmp" + sl::support::to_string(process_id());
+    {
+        sl::tinydir::file_sink sink{tmp_path};
+        sl::io::write_all(sink, {reinterpret_cast<const char*>(std::addressof(header)), sizeof(header)});
+        sl::io::write_all(sink, {reinterpret_cast<const char*>(table.records_data()),
+                table.size() * sizeof(entry_record)});
+        sl::io::write_all(sink, {reinterpret_cast<const char*>(table.slots_data()),
+                table.slots_size() * sizeof(entry_slot)});
+        sl::io::write_all(sink, {table.arena_data(), table.arena_size()});
+    }
+    try {
+        replace_file(tmp_path, cache_path);
+    } catch (...) {
+        std::remove(tmp_path.c_str());
+        throw;
+    }
+}
+
+} // namespace
+}
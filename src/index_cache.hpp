@@ -0,0 +1,79 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   index_cache.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:05 AM
+ */
+
+#ifndef STATICLIB_UNZIP_INDEX_CACHE_HPP
+#define STATICLIB_UNZIP_INDEX_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "entry_table.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Values that identify the state of the ZIP file the index cache was built for
+ */
+struct index_cache_key {
+    uint64_t archive_size = 0;
+    int64_t archive_mtime = 0;
+    uint64_t cd_offset = 0;
+    uint64_t records_count = 0;
+    uint32_t tail_crc = 0;
+};
+
+/**
+ * Returns last modification time of the specified file
+ *
+ * @param path file path
+ * @return modification time in seconds since epoch, zero on error
+ */
+int64_t file_modified_time(const std::string& path);
+
+/**
+ * Maps the index cache file into memory and attaches the table to it,
+ * header and section lengths are validated before the table is attached,
+ * records and slots are checked by the table on access
+ *
+ * @param cache_path path to the index cache file
+ * @param key expected state of the ZIP file
+ * @param table table to attach
+ * @return true if the cache file exists, matches the key and has consistent sections, false otherwise
+ */
+bool load_index_cache(const std::string& cache_path, const index_cache_key& key, entry_table& table);
+
+/**
+ * Writes the table into the index cache file, file is written under
+ * a temporary name and then renamed to replace the existing one
+ *
+ * @param cache_path path to the index cache file
+ * @param key state of the ZIP file
+ * @param table table to write
+ */
+void save_index_cache(const std::string& cache_path, const index_cache_key& key, const entry_table& table);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_INDEX_CACHE_HPP */
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   index_stats.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:38 AM
+ */
+
+#include "staticlib/unzip/index_stats.hpp"
+
+#include "staticlib/config.hpp"
+#include "staticlib/compress/zip_compression_method.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const std::memory_order relaxed = std::memory_order_relaxed;
+
+} // namespace
+
+index_stats::index_stats() {
+    for (auto& bucket : open_latency_histogram) {
+        bucket.store(0, relaxed);
+    }
+}
+
+void index_stats::record_build(uint64_t time_us, uint64_t cd_bytes) {
+    build_time_us.store(time_us, relaxed);
+    record_cd_bytes(cd_bytes);
+}
+
+void index_stats::record_cd_bytes(uint64_t cd_bytes) {
+    cd_bytes_parsed.fetch_add(cd_bytes, relaxed);
+}
+
+void index_stats::record_open(uint16_t comp_method) {
+    switch (comp_method) {
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::store):
+        opened_stored.fetch_add(1, relaxed);
+        break;
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::deflate):
+        opened_deflated.fetch_add(1, relaxed);
+        break;
+    default:
+        opened_other.fetch_add(1, relaxed);
+    }
+}
+
+void index_stats::record_open_latency(uint64_t latency_ns) {
+    uint64_t us = latency_ns / 1000;
+    size_t bucket = 0;
+    while (bucket < open_latency_buckets - 1 && us >= (static_cast<uint64_t>(1) << bucket)) {
+        bucket += 1;
+    }
+    open_latency_histogram[bucket].fetch_add(1, relaxed);
+}
+
+void index_stats::record_read(uint64_t comp_bytes, uint64_t uncomp_bytes) {
+    comp_bytes_read.fetch_add(comp_bytes, relaxed);
+    uncomp_bytes_read.fetch_add(uncomp_bytes, relaxed);
+}
+
+void index_stats::record_inflate_time(uint64_t time_ns) {
+    inflate_time_ns.fetch_add(time_ns, relaxed);
+}
+
+void index_stats::record_local_header_failure() {
+    local_header_failures.fetch_add(1, relaxed);
+}
+
+file_index_stats index_stats::snapshot() const {
+    file_index_stats res;
+    res.build_time_us = build_time_us.load(relaxed);
+    res.cd_bytes_parsed = cd_bytes_parsed.load(relaxed);
+    res.opened_stored = opened_stored.load(relaxed);
+    res.opened_deflated = opened_deflated.load(relaxed);
+    res.opened_other = opened_other.load(relaxed);
+    res.comp_bytes_read = comp_bytes_read.load(relaxed);
+    res.uncomp_bytes_read = uncomp_bytes_read.load(relaxed);
+    res.inflate_time_ns = inflate_time_ns.load(relaxed);
+    res.local_header_failures = local_header_failures.load(relaxed);
+    for (size_t i = 0; i < open_latency_buckets; i++) {
+        res.open_latency_histogram[i] = open_latency_histogram[i].load(relaxed);
+    }
+    return res;
+}
+
+} // namespace
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   inflate_checkpoints.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:34 PM
+ */
+
+#include "staticlib/unzip/inflate_checkpoints.hpp"
+
+#include <algorithm>
+
+namespace staticlib {
+namespace unzip {
+
+inflate_checkpoints::inflate_checkpoints(uint64_t interval) :
+interval(interval > 0 ? interval : 1) { }
+
+uint64_t inflate_checkpoints::get_interval() const {
+    return interval;
+}
+
+size_t inflate_checkpoints::size() const {
+    std::lock_guard<std::mutex> guard{mtx};
+    return points.size();
+}
+
+bool inflate_checkpoints::is_complete() const {
+    std::lock_guard<std::mutex> guard{mtx};
+    return complete;
+}
+
+uint64_t inflate_checkpoints::last_position() const {
+    std::lock_guard<std::mutex> guard{mtx};
+    return points.empty() ? 0 : points.back().out_pos;
+}
+
+bool inflate_checkpoints::add(inflate_checkpoint&& point) {
+    std::lock_guard<std::mutex> guard{mtx};
+    uint64_t last = points.empty() ? 0 : points.back().out_pos;
+    if (point.out_pos < last + interval) {
+        return false;
+    }
+    points.emplace_back(std::move(point));
+    return true;
+}
+
+bool inflate_checkpoints::find(uint64_t out_pos, inflate_checkpoint& point_out) const {
+    std::lock_guard<std::mutex> guard{mtx};
+    auto it = std::upper_bound(points.begin(), points.end(), out_pos,
+            [](uint64_t pos, const inflate_checkpoint& point) {
+                return pos < point.out_pos;
+            });
+    if (points.begin() == it) {
+        return false;
+    }
+    point_out = *(it - 1);
+    return true;
+}
+
+void inflate_checkpoints::set_complete() {
+    std::lock_guard<std::mutex> guard{mtx};
+    complete = true;
+}
+
+} // namespace
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_ring.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:45 AM
+ */
+
+#include "io_ring.hpp"
+
+#ifdef STATICLIB_UNZIP_WITH_IO_URING
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#endif // STATICLIB_UNZIP_WITH_IO_URING
+
+namespace staticlib {
+namespace unzip {
+
+#ifdef STATICLIB_UNZIP_WITH_IO_URING
+
+namespace { // anonymous
+
+// larger rings do not improve throughput and pin more memory
+const size_t max_queue_depth = 4096;
+
+struct read_slot {
+    struct iovec iov;
+    uint64_t tag;
+};
+
+// "io_uring" is used through the raw system calls, "liburing" is not required
+class uring : public io_ring {
+    int ring_fd = -1;
+    void* sq_ptr = MAP_FAILED;
+    size_t sq_len = 0;
+    void* cq_ptr = MAP_FAILED;
+    size_t cq_len = 0;
+    void* sqes_ptr = MAP_FAILED;
+    size_t sqes_len = 0;
+
+    unsigned* sq_tail = nullptr;
+    unsigned sq_mask = 0;
+    unsigned* sq_array = nullptr;
+    struct io_uring_sqe* sqes = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    struct io_uring_cqe* cqes = nullptr;
+
+    // iovecs must stay valid until completion, slot index is passed as "user_data"
+    std::vector<read_slot> slots;
+    std::vector<uint32_t> free_slots;
+    size_t queued = 0;
+    size_t pending = 0;
+
+public:
+    uring() { }
+
+    uring(const uring&) = delete;
+
+    uring& operator=(const uring&) = delete;
+
+    ~uring() STATICLIB_NOEXCEPT {
+        // kernel may still write into the buffers of the reads in flight
+        while (pending > 0) {
+            try {
+                wait();
+            } catch (...) {
+                break;
+            }
+        }
+        unmap(sqes_ptr, sqes_len);
+        if (cq_ptr != sq_ptr) {
+            unmap(cq_ptr, cq_len);
+        }
+        unmap(sq_ptr, sq_len);
+        if (-1 != ring_fd) {
+            ::close(ring_fd);
+        }
+    }
+
+    bool open(size_t queue_depth) {
+        struct io_uring_params params;
+        std::memset(std::addressof(params), '\0', sizeof(params));
+        unsigned entries = static_cast<unsigned>(std::min(std::max(queue_depth, static_cast<size_t>(1)),
+                max_queue_depth));
+        ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, std::addressof(params)));
+        if (ring_fd < 0) {
+            // ENOSYS on old kernels, EPERM when disabled by seccomp or sysctl
+            ring_fd = -1;
+            return false;
+        }
+        sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+        single_mmap = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+#endif // IORING_FEAT_SINGLE_MMAP
+        if (single_mmap) {
+            sq_len = std::max(sq_len, cq_len);
+            cq_len = sq_len;
+        }
+        sq_ptr = map(sq_len, IORING_OFF_SQ_RING);
+        cq_ptr = single_mmap ? sq_ptr : map(cq_len, IORING_OFF_CQ_RING);
+        sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+        sqes_ptr = map(sqes_len, IORING_OFF_SQES);
+        if (MAP_FAILED == sq_ptr || MAP_FAILED == cq_ptr || MAP_FAILED == sqes_ptr) {
+            return false;
+        }
+        char* sq = static_cast<char*>(sq_ptr);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqes = static_cast<struct io_uring_sqe*>(sqes_ptr);
+        char* cq = static_cast<char*>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+        // completion queue is larger than submission queue, so it cannot overflow
+        slots.resize(std::min(static_cast<size_t>(entries), static_cast<size_t>(params.sq_entries)));
+        for (size_t i = slots.size(); i > 0; i--) {
+            free_slots.push_back(static_cast<uint32_t>(i - 1));
+        }
+        return true;
+    }
+
+    bool read(int fd, uint64_t offset, char* buf, size_t len, uint64_t tag) override {
+        if (free_slots.empty()) {
+            return false;
+        }
+        uint32_t slot_idx = free_slots.back();
+        free_slots.pop_back();
+        read_slot& slot = slots[slot_idx];
+        slot.iov.iov_base = buf;
+        slot.iov.iov_len = len;
+        slot.tag = tag;
+        // this thread is the only producer
+        unsigned tail = *sq_tail;
+        unsigned idx = tail & sq_mask;
+        struct io_uring_sqe& sqe = sqes[idx];
+        std::memset(std::addressof(sqe), '\0', sizeof(sqe));
+        // "readv" is supported by all the "io_uring" kernels, plain "read" requires 5.6
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = fd;
+        sqe.off = offset;
+        sqe.addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(std::addressof(slot.iov)));
+        sqe.len = 1;
+        sqe.user_data = slot_idx;
+        sq_array[idx] = idx;
+        __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+        queued += 1;
+        pending += 1;
+        return true;
+    }
+
+    io_completion wait() override {
+        if (0 == pending) throw unzip_exception(TRACEMSG(
+                "Invalid wait call, no reads in flight"));
+        for (;;) {
+            unsigned head = *cq_head;
+            unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+            if (head != tail) {
+                const struct io_uring_cqe& cqe = cqes[head & cq_mask];
+                uint32_t slot_idx = static_cast<uint32_t>(cqe.user_data);
+                io_completion res;
+                res.tag = slots[slot_idx].tag;
+                res.result = cqe.res;
+                __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                free_slots.push_back(slot_idx);
+                pending -= 1;
+                return res;
+            }
+            long submitted = ::syscall(__NR_io_uring_enter, ring_fd, static_cast<unsigned>(queued), 1u,
+                    static_cast<unsigned>(IORING_ENTER_GETEVENTS), nullptr, 0);
+            if (submitted < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                throw unzip_exception(TRACEMSG(
+                        "Error submitting reads, count: [" + sl::support::to_string(queued) + "]," +
+                        " error: [" + ::strerror(errno) + "]"));
+            }
+            queued -= std::min(queued, static_cast<size_t>(submitted));
+        }
+    }
+
+    size_t in_flight() override {
+        return pending;
+    }
+
+private:
+    void* map(size_t len, uint64_t offset) {
+        return ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                static_cast<off_t>(offset));
+    }
+
+    static void unmap(void* ptr, size_t len) STATICLIB_NOEXCEPT {
+        if (MAP_FAILED != ptr) {
+            ::munmap(ptr, len);
+        }
+    }
+};
+
+} // namespace
+
+#endif // STATICLIB_UNZIP_WITH_IO_URING
+
+std::unique_ptr<io_ring> open_io_ring(size_t queue_depth) {
+#ifdef STATICLIB_UNZIP_WITH_IO_URING
+    std::unique_ptr<uring> ring{new uring()};
+    if (ring->open(queue_depth)) {
+        return std::unique_ptr<io_ring>(ring.release());
+    }
+#else // !STATICLIB_UNZIP_WITH_IO_URING
+    (void) queue_depth;
+#endif // STATICLIB_UNZIP_WITH_IO_URING
+    return std::unique_ptr<io_ring>();
+}
+
+} // namespace
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_ring.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:30 AM
+ */
+
+#ifndef STATICLIB_UNZIP_IO_RING_HPP
+#define STATICLIB_UNZIP_IO_RING_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Result of the completed read
+ */
+struct io_completion {
+    /**
+     * Tag specified on submission
+     */
+    uint64_t tag = 0;
+    /**
+     * Number of bytes read, negated "errno" value on error
+     */
+    int64_t result = 0;
+};
+
+/**
+ * Queue of the positional reads submitted to the kernel at once,
+ * destructor waits for all the reads in flight, so read buffers
+ * must outlive the ring
+ */
+class io_ring {
+public:
+    /**
+     * Destructor
+     */
+    virtual ~io_ring() STATICLIB_NOEXCEPT { }
+
+    /**
+     * Queues the positional read, reads are submitted on the next "wait" call
+     *
+     * @param fd file descriptor
+     * @param offset position in file
+     * @param buf buffer to read data into, must be valid until the read is completed
+     * @param len number of bytes to read
+     * @param tag tag reported on completion
+     * @return false if the queue is full, true otherwise
+     */
+    virtual bool read(int fd, uint64_t offset, char* buf, size_t len, uint64_t tag) = 0;
+
+    /**
+     * Submits all the queued reads and waits for a single completion
+     *
+     * @return completed read
+     * @throws unzip_exception if there are no reads in flight or on submission error
+     */
+    virtual io_completion wait() = 0;
+
+    /**
+     * Number of reads queued or submitted and not yet reported as completed
+     *
+     * @return number of reads in flight
+     */
+    virtual size_t in_flight() = 0;
+};
+
+/**
+ * Creates the ring backed by Linux "io_uring", only available when
+ * the library is built with "STATICLIB_UNZIP_WITH_IO_URING"
+ *
+ * @param queue_depth maximum number of reads in flight
+ * @return ring instance, null if "io_uring" is not supported by the build or by the kernel
+ */
+std::unique_ptr<io_ring> open_io_ring(size_t queue_depth);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_IO_RING_HPP */
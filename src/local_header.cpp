@@ -0,0 +1,77 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   local_header.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:08 PM
+ */
+
+#include "local_header.hpp"
+
+#include <array>
+
+#include "staticlib/endian.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const uint32_t zip_cd_start_signature = 0x04034b50;
+
+} // namespace
+
+uint64_t parse_local_header(sl::io::span<const char> header, uint64_t offset, const std::string& zip_file_path) {
+    auto hsrc = sl::io::array_source(header.data(), local_header_len);
+    uint32_t sig = sl::endian::read_32_le<uint32_t>(hsrc);
+    if (zip_cd_start_signature != sig) {
+        throw unzip_exception(TRACEMSG(
+                "Cannot find local file header an alleged zip file: [" + zip_file_path + "],"
+                " position: [" + sl::support::to_string(offset) + "]," +
+                " invalid signature: [" + sl::support::to_string(sig) + "]," +
+                " must be: [" + sl::support::to_string(zip_cd_start_signature) + "]"));
+    }
+    std::array<char, 32> skip;
+    sl::io::skip(hsrc, skip, 22);
+    uint16_t namelen = sl::endian::read_16_le<uint16_t>(hsrc);
+    uint16_t exlen = sl::endian::read_16_le<uint16_t>(hsrc);
+    return offset + local_header_len + namelen + exlen;
+}
+
+uint64_t find_data_offset(const std::shared_ptr<archive_reader>& reader, const file_entry& entry) {
+    uint64_t offset = static_cast<uint64_t>(entry.offset);
+    std::array<char, local_header_len> header;
+    auto src = archive_range_source(reader, offset, header.size());
+    if (header.size() != static_cast<size_t>(sl::io::read_all(src, header))) throw unzip_exception(TRACEMSG(
+            "Cannot read local file header an alleged zip file: [" + reader->path() + "],"
+            " position: [" + sl::support::to_string(offset) + "]"));
+    uint64_t data_offset = parse_local_header({header.data(), header.size()}, offset, reader->path());
+    uint64_t comp_length = static_cast<uint64_t>(entry.comp_length);
+    if (comp_length > reader->size() || data_offset > reader->size() - comp_length) throw unzip_exception(TRACEMSG(
+            "Invalid entry data bounds, offset: [" + sl::support::to_string(data_offset) + "],"
+            " length: [" + sl::support::to_string(comp_length) + "],"
+            " in ZIP file: [" + reader->path() + "]"));
+    return data_offset;
+}
+
+} // namespace
+}
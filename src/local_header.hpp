@@ -0,0 +1,70 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   local_header.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:05 PM
+ */
+
+#ifndef STATICLIB_UNZIP_LOCAL_HEADER_HPP
+#define STATICLIB_UNZIP_LOCAL_HEADER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/unzip/archive_reader.hpp"
+#include "staticlib/unzip/file_index.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Length of the fixed part of the local file header
+ */
+const size_t local_header_len = 30;
+
+/**
+ * Parses the fixed part of the local file header and returns
+ * the absolute position of the entry data
+ *
+ * @param header local file header contents, at least "local_header_len" bytes
+ * @param offset absolute position of the local file header
+ * @param zip_file_path path to the ZIP file, used for error reporting
+ * @return absolute position of the entry data
+ * @throws unzip_exception on invalid header signature
+ */
+uint64_t parse_local_header(sl::io::span<const char> header, uint64_t offset, const std::string& zip_file_path);
+
+/**
+ * Reads the local file header of the specified entry and returns
+ * the absolute position of the entry data
+ *
+ * @param reader archive reader
+ * @param entry entry description
+ * @return absolute position of the entry data
+ * @throws unzip_exception on invalid header or entry bounds
+ */
+uint64_t find_data_offset(const std::shared_ptr<archive_reader>& reader, const file_entry& entry);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_LOCAL_HEADER_HPP */
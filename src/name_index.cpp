@@ -0,0 +1,234 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   name_index.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 1:25 AM
+ */
+
+#include "name_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+// byte-wise comparison, shorter name goes first on the common prefix
+int compare_names(const char* a, size_t a_len, const char* b, size_t b_len) {
+    size_t len = std::min(a_len, b_len);
+    int res = len > 0 ? std::memcmp(a, b, len) : 0;
+    if (0 != res) {
+        return res;
+    }
+    return a_len < b_len ? -1 : (a_len > b_len ? 1 : 0);
+}
+
+bool starts_with(const entry_table& table, uint32_t id, const char* prefix, size_t prefix_len) {
+    return table.name_len(id) >= prefix_len &&
+            (0 == prefix_len || 0 == std::memcmp(table.name_data(id), prefix, prefix_len));
+}
+
+size_t literal_prefix_len(const char* pattern, size_t pattern_len) {
+    for (size_t i = 0; i < pattern_len; i++) {
+        if ('*' == pattern[i] || '?' == pattern[i]) {
+            return i;
+        }
+    }
+    return pattern_len;
+}
+
+// end position of the path segment starting at the specified position
+size_t segment_end(const char* str, size_t len, size_t pos) {
+    const char* slash = static_cast<const char*>(std::memchr(str + pos, '/', len - pos));
+    return nullptr != slash ? static_cast<size_t>(slash - str) : len;
+}
+
+// start position of the last path segment
+size_t segment_start_last(const char* str, size_t len) {
+    for (size_t i = len; i > 0; i--) {
+        if ('/' == str[i - 1]) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// "**" as a whole path segment
+bool is_globstar(const char* seg, size_t len) {
+    if (len < 2) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if ('*' != seg[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// segments contain no slashes, so only the last star needs to be
+// remembered to backtrack, when it cannot match, no earlier star can either
+bool segment_match(const char* pattern, size_t pattern_len, const char* name, size_t name_len) {
+    size_t pi = 0;
+    size_t ni = 0;
+    size_t star_pi = std::string::npos;
+    size_t star_ni = 0;
+    while (ni < name_len) {
+        if (pi < pattern_len && '*' == pattern[pi]) {
+            pi += 1;
+            star_pi = pi;
+            star_ni = ni;
+        } else if (pi < pattern_len && ('?' == pattern[pi] || pattern[pi] == name[ni])) {
+            pi += 1;
+            ni += 1;
+        } else if (std::string::npos != star_pi) {
+            // last star takes one more character
+            star_ni += 1;
+            ni = star_ni;
+            pi = star_pi;
+        } else {
+            return false;
+        }
+    }
+    while (pi < pattern_len && '*' == pattern[pi]) {
+        pi += 1;
+    }
+    return pi == pattern_len;
+}
+
+} // namespace
+
+void name_index::build(const entry_table& table) {
+    ids.resize(table.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(ids.begin(), ids.end(), [&table](uint32_t a, uint32_t b) {
+        return compare_names(table.name_data(a), table.name_len(a), table.name_data(b), table.name_len(b)) < 0;
+    });
+}
+
+sl::io::span<const uint32_t> name_index::prefix(const entry_table& table, const char* prefix,
+        size_t prefix_len) const {
+    auto begin = std::lower_bound(ids.begin(), ids.end(), 0, [&](uint32_t id, int) {
+        return compare_names(table.name_data(id), table.name_len(id), prefix, prefix_len) < 0;
+    });
+    auto end = std::partition_point(begin, ids.end(), [&](uint32_t id) {
+        return starts_with(table, id, prefix, prefix_len);
+    });
+    return sl::io::span<const uint32_t>(ids.data() + (begin - ids.begin()), static_cast<size_t>(end - begin));
+}
+
+void name_index::children(const entry_table& table, const char* dir, size_t dir_len,
+        std::vector<sl::io::span<const char>>& out) const {
+    auto range = prefix(table, dir, dir_len);
+    const uint32_t* it = range.data();
+    const uint32_t* end = range.data() + range.size();
+    while (it != end) {
+        const char* name = table.name_data(*it);
+        size_t name_len = table.name_len(*it);
+        if (name_len == dir_len) {
+            // directory own record
+            ++it;
+            continue;
+        }
+        const char* slash = static_cast<const char*>(std::memchr(name + dir_len, '/', name_len - dir_len));
+        if (nullptr == slash) {
+            out.emplace_back(name, name_len);
+            ++it;
+            continue;
+        }
+        size_t child_len = static_cast<size_t>(slash - name) + 1;
+        out.emplace_back(name, child_len);
+        // all the records under this subdirectory are skipped
+        it = std::partition_point(it, end, [&](uint32_t id) {
+            return starts_with(table, id, name, child_len);
+        });
+    }
+}
+
+void name_index::glob(const entry_table& table, const char* pattern, size_t pattern_len,
+        std::vector<uint32_t>& out) const {
+    auto range = prefix(table, pattern, literal_prefix_len(pattern, pattern_len));
+    for (size_t i = 0; i < range.size(); i++) {
+        uint32_t id = range.data()[i];
+        if (glob_match(pattern, pattern_len, table.name_data(id), table.name_len(id))) {
+            out.push_back(id);
+        }
+    }
+}
+
+bool glob_match(const char* pattern, size_t pattern_len, const char* name, size_t name_len) {
+    // segments are addressed by their start positions, position "len + 1" is after the last segment
+    size_t pattern_limit = pattern_len + 1;
+    size_t name_limit = name_len + 1;
+    // trailing "**" takes at least the last name segment, the rest is
+    // matched as if the pattern had a trailing "**" that takes any segments
+    size_t last_pattern_seg = segment_start_last(pattern, pattern_len);
+    bool open_end = is_globstar(pattern + last_pattern_seg, pattern_len - last_pattern_seg);
+    if (open_end) {
+        pattern_limit = last_pattern_seg;
+        name_limit = segment_start_last(name, name_len);
+    }
+    size_t ps = 0;
+    size_t ns = 0;
+    // pattern position after the last "**" seen and the name position it is matched up to
+    size_t star_ps = std::string::npos;
+    size_t star_ns = 0;
+    while (ns < name_limit) {
+        if (ps < pattern_limit) {
+            size_t pe = segment_end(pattern, pattern_len, ps);
+            if (is_globstar(pattern + ps, pe - ps)) {
+                ps = pe + 1;
+                star_ps = ps;
+                star_ns = ns;
+                continue;
+            }
+            size_t ne = segment_end(name, name_len, ns);
+            if (segment_match(pattern + ps, pe - ps, name + ns, ne - ns)) {
+                ps = pe + 1;
+                ns = ne + 1;
+                continue;
+            }
+        } else if (open_end) {
+            return true;
+        }
+        if (std::string::npos == star_ps) {
+            return false;
+        }
+        // last "**" takes one more segment
+        star_ns = segment_end(name, name_len, star_ns) + 1;
+        ns = star_ns;
+        ps = star_ps;
+    }
+    while (ps < pattern_limit) {
+        size_t pe = segment_end(pattern, pattern_len, ps);
+        if (!is_globstar(pattern + ps, pe - ps)) {
+            return false;
+        }
+        ps = pe + 1;
+    }
+    return true;
+}
+
+} // namespace
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   name_index.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 1:10 AM
+ */
+
+#ifndef STATICLIB_UNZIP_NAME_INDEX_HPP
+#define STATICLIB_UNZIP_NAME_INDEX_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "staticlib/io/span.hpp"
+
+#include "entry_table.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Record ids of the entry table sorted by the byte-wise order of the names,
+ * names sharing a prefix form a contiguous range of ids
+ */
+class name_index {
+    std::vector<uint32_t> ids;
+
+public:
+    /**
+     * Sorts ids of all the records of the specified table
+     *
+     * @param table entry table, must not be changed after this call
+     */
+    void build(const entry_table& table);
+
+    /**
+     * Returns sorted ids of the records with names starting with the specified prefix
+     *
+     * @param table entry table this index was built from
+     * @param prefix pointer to prefix
+     * @param prefix_len prefix length
+     * @return view over sorted ids
+     */
+    sl::io::span<const uint32_t> prefix(const entry_table& table, const char* prefix, size_t prefix_len) const;
+
+    /**
+     * Collects names of the immediate children of the specified directory, subdirectories
+     * are reported once with the trailing slash even if they have no own records,
+     * whole subdirectory ranges are skipped with binary search
+     *
+     * @param table entry table this index was built from
+     * @param dir directory name with trailing slash, empty for the root directory
+     * @param dir_len directory name length
+     * @param out output views pointing into the table names
+     */
+    void children(const entry_table& table, const char* dir, size_t dir_len,
+            std::vector<sl::io::span<const char>>& out) const;
+
+    /**
+     * Collects sorted ids of the records with names matching the specified glob
+     * pattern, only records under the literal prefix of the pattern are checked
+     *
+     * @param table entry table this index was built from
+     * @param pattern pointer to pattern
+     * @param pattern_len pattern length
+     * @param out output ids
+     */
+    void glob(const entry_table& table, const char* pattern, size_t pattern_len,
+            std::vector<uint32_t>& out) const;
+};
+
+/**
+ * Matches name against the glob pattern, "*" matches any characters except slash,
+ * "?" matches a single character except slash, "**" as a whole path segment
+ * matches any number of directories (trailing "**" matches at least one segment,
+ * "**" inside a segment is the same as "*"), only the last star is backtracked
+ * to, so the matching time is polynomial in the pattern and name lengths
+ *
+ * @param pattern pointer to pattern
+ * @param pattern_len pattern length
+ * @param name pointer to name
+ * @param name_len name length
+ * @return true if name matches the pattern
+ */
+bool glob_match(const char* pattern, size_t pattern_len, const char* name, size_t name_len);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_NAME_INDEX_HPP */
@@ -23,128 +23,1227 @@
 
 #include "staticlib/unzip/operations.hpp"
 
+#include <cerrno>
 #include <cstring>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <ios>
+#include <mutex>
+#include <set>
 #include <string>
 #include <memory>
+#include <thread>
+#include <vector>
 
 // http://stackoverflow.com/a/1904659/314015
 #define NOMINMAX
 
+#include "zlib.h"
+
 #include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include <windows.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
 #include "staticlib/endian.hpp"
 #include "staticlib/io.hpp"
 #include "staticlib/compress.hpp"
 #include "staticlib/utils.hpp"
-#include "staticlib/tinydir.hpp"
 
+#include "staticlib/unzip/entry_codec.hpp"
 #include "staticlib/unzip/unzip_exception.hpp"
 
+#include "counting_source.hpp"
+#include "crc32.hpp"
+#include "deflated_source.hpp"
+#include "io_ring.hpp"
+#include "local_header.hpp"
+#include "run_workers.hpp"
+#include "zip_format.hpp"
 
 namespace staticlib {
 namespace unzip {
 
 namespace { // anonymous
 
-const uint32_t zip_cd_start_signature = 0x04034b50;
+const size_t extract_buffer_size = 1 << 16;
+// local extra field length is not known before the header is read
+const size_t local_extra_slack = 256;
 
-class unzip_entry_source {
-    using tinydir_file_ref_type = sl::io::reference_source<sl::tinydir::file_source>;
-    using inflater_type = sl::compress::inflate_source<tinydir_file_ref_type>;
+// entry names are passed as spans, strings are only built for error messages
+std::string name_string(sl::io::span<const char> name) {
+    return std::string(name.data(), name.size());
+}
 
-    std::string zip_file_path;
-    std::string zip_entry_name;
-    file_entry entry; 
-    sl::tinydir::file_source fd;
-    std::unique_ptr<inflater_type> inflater;
+// source over the entry data that counts compressed bytes read from the archive
+template<typename Source>
+using counted_source_ref = sl::io::reference_source<counting_source<Source>>;
 
-    size_t avail_out;
+// entry source that records read counters into the index stats, decoder is
+// constructed over the counted reference to the specified source, clock is
+// read only for the compressed entries
+template<typename Source, typename Decoder>
+class recorded_entry_source {
+    Source src;
+    counting_source<Source> counted;
+    Decoder decoder;
+    std::shared_ptr<index_stats> stats;
+    bool timed;
+    uint64_t comp_recorded = 0;
 
 public:
-    unzip_entry_source(const std::string& zip_file_path, const std::string& zip_entry_name, file_entry entry) : 
-    zip_file_path(std::string(zip_file_path.data(), zip_file_path.length())),
-    zip_entry_name(std::string(zip_entry_name.data(), zip_entry_name.length())),
-    entry(entry),
-    fd(this->zip_file_path),
-    inflater(nullptr),
-    avail_out(entry.uncomp_length) {
-        fd.seek(entry.offset);
-        check_header();
-        switch (this->entry.comp_method) {
-        case static_cast<uint16_t>(sl::compress::zip_compression_method::store): break;
-        case static_cast<uint16_t>(sl::compress::zip_compression_method::deflate): inflater.reset(
-                new sl::compress::inflate_source<tinydir_file_ref_type>(
-                        sl::io::make_reference_source(this->fd)));
-            break;
-        default: throw unzip_exception(TRACEMSG(
-                "Unsupported compression method: [" + sl::support::to_string(this->entry.comp_method) + "],"
-                " in entry: [" + this->zip_entry_name + "],"
-                " in ZIP file: [" + this->zip_file_path + "]"));
+    template<typename... Args>
+    recorded_entry_source(Source&& src, std::shared_ptr<index_stats> stats, bool timed, Args&&... args) :
+    src(std::move(src)),
+    counted(this->src),
+    decoder(sl::io::make_reference_source(counted), std::forward<Args>(args)...),
+    stats(std::move(stats)),
+    timed(timed) { }
+
+    recorded_entry_source(const recorded_entry_source&) = delete;
+
+    recorded_entry_source& operator=(const recorded_entry_source&) = delete;
+
+    std::streamsize read(sl::io::span<char> span) {
+        std::streamsize res = 0;
+        if (timed) {
+            auto start = std::chrono::steady_clock::now();
+            res = decoder.read(span);
+            stats->record_inflate_time(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()));
+        } else {
+            res = decoder.read(span);
         }
+        uint64_t comp = counted.get_count();
+        stats->record_read(comp - comp_recorded, res > 0 ? static_cast<uint64_t>(res) : 0);
+        comp_recorded = comp;
+        return res;
     }
- 
+};
+
+// checks CRC-32 of the entry data when the end of entry is reached
+template<typename Inner>
+class crc_verifying_source {
+    Inner inner;
+    std::string entry_name;
+    uint32_t expected;
+    uint64_t avail;
+    uint32_t crc = 0;
+
+public:
+    template<typename... Args>
+    crc_verifying_source(sl::io::span<const char> entry_name, const file_entry& desc, Args&&... args) :
+    inner(std::forward<Args>(args)...),
+    entry_name(entry_name.data(), entry_name.size()),
+    expected(desc.crc),
+    avail(static_cast<uint64_t>(desc.uncomp_length)) { }
+
+    crc_verifying_source(const crc_verifying_source&) = delete;
+
+    crc_verifying_source& operator=(const crc_verifying_source&) = delete;
+
     std::streamsize read(sl::io::span<char> span) {
-        if (avail_out > 0) {
-            size_t len_out = span.size() <= avail_out ? span.size() : avail_out;
-            size_t res = read_data(span.data(), len_out);
-            avail_out -= res;
-            return res > 0 ? res : std::char_traits<char>::eof();
-        } 
-        return std::char_traits<char>::eof();
-    }
- 
-private:
-    void check_header() {
-        uint32_t sig = sl::endian::read_32_le<uint32_t>(fd);
-        if (zip_cd_start_signature != sig) {
+        std::streamsize res = inner.read(span);
+        if (res > 0) {
+            crc = crc32_update(crc, span.data(), static_cast<size_t>(res));
+            avail -= std::min(avail, static_cast<uint64_t>(res));
+            if (0 == avail && expected != crc) throw unzip_exception(TRACEMSG(
+                    "CRC-32 mismatch in zip entry: [" + entry_name + "]," +
+                    " expected: [" + sl::support::to_string(expected) + "]," +
+                    " actual: [" + sl::support::to_string(crc) + "]"));
+        } else if (std::char_traits<char>::eof() == res && avail > 0) {
+            // data that ends early cannot be checked by CRC-32
             throw unzip_exception(TRACEMSG(
-                    "Cannot find local file header an alleged zip file: [" + zip_file_path + "],"
-                    " position: [" + sl::support::to_string(entry.offset) + "]," +
-                    " invalid signature: [" + sl::support::to_string(sig) + "]," +
-                    " must be: [" + sl::support::to_string(zip_cd_start_signature) + "]"));
+                    "Unexpected end of data in zip entry: [" + entry_name + "]," +
+                    " bytes missing: [" + sl::support::to_string(avail) + "]"));
         }
-        std::array<char, 32> skip;
-        sl::io::skip(fd, skip, 22);
-        uint16_t namelen = sl::endian::read_16_le<uint16_t>(fd);
-        uint16_t exlen = sl::endian::read_16_le<uint16_t>(fd);
-        sl::io::skip(fd, skip, namelen + exlen);
+        return res;
     }
+};
 
-    size_t read_data(char* buffer, size_t len_out) {
-            switch (entry.comp_method) {
-            case static_cast<uint16_t>(sl::compress::zip_compression_method::store): {
-                return sl::io::read_all(fd, {buffer, len_out});
+// entry source over the output of the registered codec
+class codec_entry_source {
+    std::unique_ptr<codec_source> decoder;
+
+public:
+    template<typename Source>
+    codec_entry_source(Source&& src, const entry_codec& codec, uint64_t uncomp_length) :
+    decoder(codec.open_decoder(make_codec_source(std::move(src)), uncomp_length)) { }
+
+    std::streamsize read(sl::io::span<char> span) {
+        return decoder->read(span);
+    }
+};
+
+std::shared_ptr<const entry_codec> find_codec_checked(sl::io::span<const char> entry_name, const file_entry& desc,
+        const std::string& zip_file_path) {
+    auto codec = find_codec(desc.comp_method);
+    if (nullptr == codec.get()) throw unzip_exception(TRACEMSG(
+            "Unsupported compression method: [" + sl::support::to_string(desc.comp_method) + "],"
+            " in entry: [" + name_string(entry_name) + "],"
+            " in ZIP file: [" + zip_file_path + "]"));
+    return codec;
+}
+
+template<typename Inner, typename... Args>
+std::unique_ptr<std::istream> make_checked_istream(bool verify_crc, sl::io::span<const char> entry_name,
+        const file_entry& desc, Args&&... args) {
+    if (verify_crc) {
+        auto uzs = sl::io::make_unique_source(new crc_verifying_source<Inner>(
+                entry_name, desc, std::forward<Args>(args)...));
+        return sl::io::make_source_istream_ptr(std::move(uzs));
+    }
+    auto uzs = sl::io::make_unique_source(new Inner(std::forward<Args>(args)...));
+    return sl::io::make_source_istream_ptr(std::move(uzs));
+}
+
+template<sl::compress::zip_compression_method Method, typename Source>
+std::unique_ptr<std::istream> make_entry_istream(Source&& src, sl::io::span<const char> entry_name,
+        const file_entry& desc, std::shared_ptr<index_stats> stats, bool verify_crc) {
+    if (nullptr == stats.get()) {
+        return make_checked_istream<typename native_entry_source<Source, Method>::type>(
+                verify_crc, entry_name, desc, std::move(src), static_cast<uint64_t>(desc.uncomp_length));
+    }
+    return make_checked_istream<recorded_entry_source<Source,
+            typename native_entry_source<counted_source_ref<Source>, Method>::type>>(
+            verify_crc, entry_name, desc, std::move(src), std::move(stats),
+            sl::compress::zip_compression_method::deflate == Method, static_cast<uint64_t>(desc.uncomp_length));
+}
+
+// compression method is dispatched once on open, not on every read
+template<typename Source>
+std::unique_ptr<std::istream> make_entry_istream(const std::shared_ptr<archive_reader>& reader,
+        sl::io::span<const char> entry_name, const file_entry& desc, Source&& src, std::shared_ptr<index_stats> stats,
+        bool verify_crc) {
+    switch (desc.comp_method) {
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::store):
+        return make_entry_istream<sl::compress::zip_compression_method::store>(
+                std::move(src), entry_name, desc, std::move(stats), verify_crc);
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::deflate):
+        return make_entry_istream<sl::compress::zip_compression_method::deflate>(
+                std::move(src), entry_name, desc, std::move(stats), verify_crc);
+    default: {
+        auto codec = find_codec_checked(entry_name, desc, reader->path());
+        if (nullptr == stats.get()) {
+            return make_checked_istream<codec_entry_source>(verify_crc, entry_name, desc,
+                    std::move(src), *codec, static_cast<uint64_t>(desc.uncomp_length));
+        }
+        return make_checked_istream<recorded_entry_source<Source, codec_entry_source>>(verify_crc, entry_name, desc,
+                std::move(src), std::move(stats), true, *codec, static_cast<uint64_t>(desc.uncomp_length));
+    }
+    }
+}
+
+uint64_t find_local_data(const std::shared_ptr<archive_reader>& reader, const file_entry& desc,
+        const std::shared_ptr<index_stats>& stats) {
+    if (nullptr == stats.get()) {
+        return find_data_offset(reader, desc);
+    }
+    try {
+        return find_data_offset(reader, desc);
+    } catch (const std::exception&) {
+        stats->record_local_header_failure();
+        throw;
+    }
+}
+
+class cached_entry_streambuf : public std::streambuf {
+    std::shared_ptr<const std::vector<char>> data;
+
+public:
+    explicit cached_entry_streambuf(std::shared_ptr<const std::vector<char>> data) :
+    data(std::move(data)) {
+        // cached data is never modified, get area points directly to it
+        char* begin = const_cast<char*>(this->data->data());
+        setg(begin, begin, begin + this->data->size());
+    }
+};
+
+class cached_entry_istream : public std::istream {
+    cached_entry_streambuf buf;
+
+public:
+    explicit cached_entry_istream(std::shared_ptr<const std::vector<char>> data) :
+    std::istream(nullptr),
+    buf(std::move(data)) {
+        rdbuf(std::addressof(buf));
+    }
+};
+
+std::unique_ptr<std::istream> open_entry_stream(const file_index& idx, sl::io::span<const char> entry_name,
+        const file_entry& desc) {
+    try {
+        auto reader = idx.get_archive_reader();
+        auto stats = idx.get_stats_collector();
+        uint64_t data_offset = find_local_data(reader, desc, stats);
+        uint64_t comp_length = static_cast<uint64_t>(desc.comp_length);
+        if (nullptr != stats.get()) {
+            stats->record_open(desc.comp_method);
+        }
+        if (idx.is_memory_mapped()) {
+            auto src = sl::io::array_source(reader->data().data() + data_offset, static_cast<size_t>(comp_length));
+            return make_entry_istream(reader, entry_name, desc, std::move(src), std::move(stats),
+                    idx.is_crc_verified());
+        }
+        auto src = archive_range_source(reader, data_offset, comp_length);
+        return make_entry_istream(reader, entry_name, desc, std::move(src), std::move(stats),
+                idx.is_crc_verified());
+    } catch (const std::exception& e) {
+        throw unzip_exception(TRACEMSG(
+                "Error opening zip entry: [" + name_string(entry_name) + "]" +
+                " from zip file: [" + idx.get_zip_file_path() + "]" +
+                " with offset: [" + sl::support::to_string(desc.offset) + "]," +
+                " length: [" + sl::support::to_string(desc.comp_length) + "]" +
+                "\n" + e.what()));
+    }
+}
+
+// inflates the whole raw deflate stream from memory without intermediate buffers
+void inflate_whole(const char* in, size_t in_len, char* out, size_t out_len, sl::io::span<const char> entry_name,
+        const std::string& zip_file_path) {
+    z_stream strm;
+    std::memset(std::addressof(strm), '\0', sizeof(strm));
+    if (Z_OK != ::inflateInit2(std::addressof(strm), -MAX_WBITS)) throw unzip_exception(TRACEMSG(
+            "Inflate initialization error, entry: [" + name_string(entry_name) + "]"));
+    // zlib rejects null output pointer even for empty output
+    char empty_out = '\0';
+    size_t in_avail = in_len;
+    size_t out_avail = out_len;
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+    strm.next_out = reinterpret_cast<Bytef*>(out_len > 0 ? out : std::addressof(empty_out));
+    int err = Z_OK;
+    while (Z_OK == err) {
+        if (0 == strm.avail_in && in_avail > 0) {
+            strm.avail_in = static_cast<uInt>(std::min(in_avail, inflate_chunk_max));
+            in_avail -= strm.avail_in;
+        }
+        if (0 == strm.avail_out && out_avail > 0) {
+            strm.avail_out = static_cast<uInt>(std::min(out_avail, inflate_chunk_max));
+            out_avail -= strm.avail_out;
+        }
+        bool last = 0 == in_avail && 0 == out_avail;
+        err = ::inflate(std::addressof(strm), last ? Z_FINISH : Z_NO_FLUSH);
+    }
+    size_t produced = out_len - out_avail - strm.avail_out;
+    ::inflateEnd(std::addressof(strm));
+    if (Z_STREAM_END != err || out_len != produced) throw unzip_exception(TRACEMSG(
+            "Inflate error: [" + sl::support::to_string(err) + "]," +
+            " expected length: [" + sl::support::to_string(out_len) + "]," +
+            " actual: [" + sl::support::to_string(produced) + "]," +
+            " entry: [" + name_string(entry_name) + "],"
+            " in ZIP file: [" + zip_file_path + "]"));
+}
+
+// reads the whole entry with a single read and one-shot inflate
+void read_entry_direct(const file_index& idx, sl::io::span<const char> entry_name, const file_entry& desc,
+        char* out) {
+    try {
+        auto reader = idx.get_archive_reader();
+        auto stats = idx.get_stats_collector();
+        uint64_t data_offset = find_local_data(reader, desc, stats);
+        size_t comp_length = static_cast<size_t>(desc.comp_length);
+        size_t uncomp_length = static_cast<size_t>(desc.uncomp_length);
+        if (nullptr != stats.get()) {
+            stats->record_open(desc.comp_method);
+        }
+        switch (desc.comp_method) {
+        case static_cast<uint16_t>(sl::compress::zip_compression_method::store): {
+            if (comp_length != uncomp_length) throw unzip_exception(TRACEMSG(
+                    "Invalid stored entry: [" + name_string(entry_name) + "],"
+                    " compressed length: [" + sl::support::to_string(comp_length) + "],"
+                    " uncompressed length: [" + sl::support::to_string(uncomp_length) + "]"));
+            if (idx.is_memory_mapped()) {
+                if (comp_length > 0) {
+                    std::memcpy(out, reader->data().data() + data_offset, comp_length);
+                }
+            } else {
+                auto src = archive_range_source(reader, data_offset, comp_length);
+                sl::io::read_exact(src, {out, comp_length});
+            }
+            if (nullptr != stats.get()) {
+                stats->record_read(comp_length, comp_length);
+            }
+            break;
+        }
+        default: {
+            // codec is looked up before reading the compressed data
+            std::shared_ptr<const entry_codec> codec;
+            if (static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) != desc.comp_method) {
+                codec = find_codec_checked(entry_name, desc, reader->path());
+            }
+            std::vector<char> comp;
+            const char* in = nullptr;
+            if (idx.is_memory_mapped()) {
+                in = reader->data().data() + data_offset;
+            } else {
+                comp.resize(comp_length);
+                auto src = archive_range_source(reader, data_offset, comp_length);
+                sl::io::read_exact(src, {comp.data(), comp_length});
+                in = comp.data();
+            }
+            // only the decompression is timed, clock is not read without stats
+            std::chrono::steady_clock::time_point start;
+            if (nullptr != stats.get()) {
+                start = std::chrono::steady_clock::now();
+            }
+            if (nullptr != codec.get()) {
+                codec->decode({in, comp_length}, {out, uncomp_length});
+            } else {
+                inflate_whole(in, comp_length, out, uncomp_length, entry_name, reader->path());
+            }
+            if (nullptr != stats.get()) {
+                stats->record_inflate_time(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count()));
+                stats->record_read(comp_length, uncomp_length);
+            }
+            break;
+        }
+        }
+        if (idx.is_crc_verified()) {
+            uint32_t crc = crc32_update(0, out, uncomp_length);
+            if (desc.crc != crc) throw unzip_exception(TRACEMSG(
+                    "CRC-32 mismatch, expected: [" + sl::support::to_string(desc.crc) + "]," +
+                    " actual: [" + sl::support::to_string(crc) + "]"));
+        }
+    } catch (const std::exception& e) {
+        throw unzip_exception(TRACEMSG(
+                "Error reading zip entry: [" + name_string(entry_name) + "]" +
+                " from zip file: [" + idx.get_zip_file_path() + "]" +
+                " with offset: [" + sl::support::to_string(desc.offset) + "]," +
+                " length: [" + sl::support::to_string(desc.comp_length) + "]" +
+                "\n" + e.what()));
+    }
+}
+
+std::shared_ptr<const std::vector<char>> read_entry_data(const file_index& idx, sl::io::span<const char> entry_name,
+        const file_entry& desc) {
+    auto data = std::make_shared<std::vector<char>>();
+    data->resize(static_cast<size_t>(desc.uncomp_length));
+    read_entry_direct(idx, entry_name, desc, data->data());
+    return data;
+}
+
+// cached data is copied if present, cache is not populated
+void read_entry_cached(const file_index& idx, sl::io::span<const char> entry_name, const file_entry& desc,
+        char* out) {
+    auto cache = idx.get_entry_cache();
+    if (nullptr != cache.get()) {
+        auto data = cache->get(static_cast<uint64_t>(desc.offset));
+        if (nullptr != data.get()) {
+            if (data->size() > 0) {
+                std::memcpy(out, data->data(), data->size());
+            }
+            return;
+        }
+    }
+    read_entry_direct(idx, entry_name, desc, out);
+}
+
+file_entry find_entry_checked(const file_index& idx, const std::string& entry_name) {
+    auto desc = idx.find_zip_entry(entry_name);
+    if (-1 == desc.offset) throw unzip_exception(TRACEMSG(
+            "Specified zip entry not found: [" + entry_name + "]"));
+    return desc;
+}
+
+struct batch_task {
+    const std::string* name;
+    file_entry entry;
+    uint64_t end;
+
+    batch_task(const std::string* name, file_entry entry, uint64_t end) :
+    name(name),
+    entry(entry),
+    end(end) { }
+};
+
+void deliver_entry(const file_index& idx, const batch_task& task, const std::shared_ptr<archive_reader>& reader,
+        const std::vector<char>& buf, uint64_t buf_offset, size_t buf_len,
+        const std::function<void(const std::string&, std::istream&)>& callback) {
+    uint64_t offset = static_cast<uint64_t>(task.entry.offset);
+    uint64_t comp_length = static_cast<uint64_t>(task.entry.comp_length);
+    uint64_t buf_end = buf_offset + buf_len;
+    if (offset + local_header_len <= buf_end) {
+        auto stats = idx.get_stats_collector();
+        uint64_t data_offset = 0;
+        try {
+            data_offset = parse_local_header({buf.data() + (offset - buf_offset), local_header_len},
+                    offset, reader->path());
+        } catch (const std::exception&) {
+            if (nullptr != stats.get()) {
+                stats->record_local_header_failure();
             }
-            case static_cast<uint16_t>(sl::compress::zip_compression_method::deflate): {
-                return sl::io::read_all(*inflater, {buffer, len_out});
+            throw;
+        }
+        if (data_offset + comp_length <= buf_end) {
+            if (nullptr != stats.get()) {
+                stats->record_open(task.entry.comp_method);
             }
-            default: throw unzip_exception(TRACEMSG(
-                    "Unsupported compression method: [" + sl::support::to_string(entry.comp_method) + "],"
-                    " in entry: [" + zip_entry_name + "],"
-                    " in ZIP file: [" + zip_file_path + "]"));
+            auto src = sl::io::array_source(buf.data() + (data_offset - buf_offset), static_cast<size_t>(comp_length));
+            auto stream = make_entry_istream(reader, {task.name->data(), task.name->length()}, task.entry,
+                    std::move(src), std::move(stats), idx.is_crc_verified());
+            callback(*task.name, *stream);
+            return;
+        }
+    }
+    // local extra field is longer than expected
+    auto stream = open_entry_stream(idx, {task.name->data(), task.name->length()}, task.entry);
+    callback(*task.name, *stream);
+}
+
+struct batch_group {
+    size_t first;
+    size_t last;
+    uint64_t start;
+    size_t len;
+    bool streamed;
+
+    batch_group(size_t first, size_t last, uint64_t start, size_t len, bool streamed) :
+    first(first),
+    last(last),
+    start(start),
+    len(len),
+    streamed(streamed) { }
+};
+
+std::vector<batch_group> make_batch_groups(const std::vector<batch_task>& tasks, const batch_options& options) {
+    std::vector<batch_group> res;
+    for (size_t i = 0; i < tasks.size();) {
+        uint64_t start = static_cast<uint64_t>(tasks[i].entry.offset);
+        uint64_t end = tasks[i].end;
+        size_t next = i + 1;
+        while (next < tasks.size() &&
+                static_cast<uint64_t>(tasks[next].entry.offset) <= end + options.max_gap &&
+                std::max(end, tasks[next].end) - start <= options.max_read_size) {
+            end = std::max(end, tasks[next].end);
+            next += 1;
+        }
+        if (end - start > options.max_read_size) {
+            // single large entry is streamed on its own
+            res.emplace_back(i, next, start, 0, true);
+        } else {
+            res.emplace_back(i, next, start, static_cast<size_t>(end - start), false);
+        }
+        i = next;
+    }
+    return res;
+}
+
+void deliver_streamed(const file_index& idx, const batch_task& task,
+        const std::function<void(const std::string&, std::istream&)>& callback) {
+    auto stream = open_entry_stream(idx, {task.name->data(), task.name->length()}, task.entry);
+    callback(*task.name, *stream);
+}
+
+bool deliver_groups_ring(const file_index& idx, const std::vector<batch_task>& tasks,
+        const std::vector<batch_group>& groups, const std::shared_ptr<archive_reader>& reader,
+        const batch_options& options, const std::function<void(const std::string&, std::istream&)>& callback) {
+    // buffers must outlive the ring, its destructor waits for the reads in flight
+    std::vector<std::vector<char>> bufs;
+    bufs.resize(groups.size());
+    std::vector<int64_t> results;
+    results.resize(groups.size(), 0);
+    std::vector<char> completed;
+    completed.resize(groups.size(), 0);
+    auto ring = open_io_ring(options.io_queue_depth);
+    if (nullptr == ring.get()) {
+        return false;
+    }
+    int fd = reader->file_descriptor();
+    size_t submitted = 0;
+    size_t budget_used = 0;
+    for (size_t g = 0; g < groups.size(); g++) {
+        // reads ahead are limited by the queue depth and by the buffers budget,
+        // the current group is always submitted
+        while (submitted < groups.size()) {
+            auto& next = groups[submitted];
+            if (!next.streamed) {
+                if (submitted > g && budget_used + next.len > options.io_buffer_budget) {
+                    break;
+                }
+                bufs[submitted].resize(next.len);
+                if (!ring->read(fd, next.start, bufs[submitted].data(), next.len, submitted)) {
+                    break;
+                }
+                budget_used += next.len;
             }
+            submitted += 1;
+        }
+        auto& gr = groups[g];
+        if (gr.streamed) {
+            deliver_streamed(idx, tasks[gr.first], callback);
+            continue;
+        }
+        while (0 == completed[g]) {
+            auto comp = ring->wait();
+            completed[comp.tag] = 1;
+            results[comp.tag] = comp.result;
+        }
+        if (results[g] < 0) throw unzip_exception(TRACEMSG(
+                "Error reading ZIP file: [" + reader->path() + "]," +
+                " position: [" + sl::support::to_string(gr.start) + "]," +
+                " error: [" + ::strerror(static_cast<int>(-results[g])) + "]"));
+        size_t buf_len = static_cast<size_t>(results[g]);
+        auto& buf = bufs[g];
+        if (buf_len > 0 && buf_len < gr.len) {
+            // short read, the rest is read synchronously
+            auto src = archive_range_source(reader, gr.start + buf_len, gr.len - buf_len);
+            auto read = sl::io::read_all(src, {buf.data() + buf_len, gr.len - buf_len});
+            buf_len += read > 0 ? static_cast<size_t>(read) : 0;
+        }
+        for (size_t i = gr.first; i < gr.last; i++) {
+            deliver_entry(idx, tasks[i], reader, buf, gr.start, buf_len, callback);
+        }
+        budget_used -= gr.len;
+        std::vector<char>().swap(buf);
     }
+    return true;
+}
+
+struct extract_task {
+    const std::string* name;
+    file_entry entry;
+
+    extract_task(const std::string* name, file_entry entry) :
+    name(name),
+    entry(entry) { }
 };
 
+class output_file {
+    std::string file_path;
+#ifdef STATICLIB_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+#else // !STATICLIB_WINDOWS
+    int fd = -1;
+#endif // STATICLIB_WINDOWS
+
+public:
+    output_file(const std::string& file_path, uint64_t size) :
+    file_path(file_path.data(), file_path.length()) {
+        open_file(size);
+    }
+
+    output_file(const output_file&) = delete;
+
+    output_file& operator=(const output_file&) = delete;
+
+    ~output_file() STATICLIB_NOEXCEPT {
+        close_file();
+    }
+
+    std::streamsize flush() {
+        return 0;
+    }
+
+#ifdef STATICLIB_WINDOWS
+    std::streamsize write(sl::io::span<const char> span) {
+        DWORD len = span.size() <= 0x40000000 ? static_cast<DWORD>(span.size()) : 0x40000000;
+        DWORD written = 0;
+        if (0 == ::WriteFile(file, span.data(), len, std::addressof(written), NULL)) throw unzip_exception(TRACEMSG(
+                "Error writing file: [" + file_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return static_cast<std::streamsize>(written);
+    }
+
+private:
+    void open_file(uint64_t size) {
+        auto wpath = sl::utils::widen(file_path);
+        file = ::CreateFileW(wpath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (INVALID_HANDLE_VALUE == file) throw unzip_exception(TRACEMSG(
+                "Error opening file: [" + file_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        if (size > 0) {
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(size);
+            LARGE_INTEGER start;
+            start.QuadPart = 0;
+            if (0 == ::SetFilePointerEx(file, end, NULL, FILE_BEGIN) ||
+                    0 == ::SetEndOfFile(file) ||
+                    0 == ::SetFilePointerEx(file, start, NULL, FILE_BEGIN)) {
+                auto err = ::GetLastError();
+                close_file();
+                throw unzip_exception(TRACEMSG(
+                        "Error allocating file: [" + file_path + "]," +
+                        " size: [" + sl::support::to_string(size) + "]," +
+                        " error: [" + sl::utils::errcode_to_string(err) + "]"));
+            }
+        }
+    }
+
+    void close_file() STATICLIB_NOEXCEPT {
+        if (INVALID_HANDLE_VALUE != file) {
+            ::CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+    }
+#else // !STATICLIB_WINDOWS
+    std::streamsize write(sl::io::span<const char> span) {
+        for (;;) {
+            auto res = ::write(fd, span.data(), span.size());
+            if (res >= 0) {
+                return static_cast<std::streamsize>(res);
+            }
+            if (EINTR != errno) throw unzip_exception(TRACEMSG(
+                    "Error writing file: [" + file_path + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+        }
+    }
+
+private:
+    void open_file(uint64_t size) {
+        fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (-1 == fd) throw unzip_exception(TRACEMSG(
+                "Error opening file: [" + file_path + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+#ifdef STATICLIB_LINUX
+        if (size > 0) {
+            int err = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+            // preallocation is only a hint on file systems that do not support it
+            if (0 != err && EOPNOTSUPP != err && EINVAL != err) {
+                close_file();
+                throw unzip_exception(TRACEMSG(
+                        "Error allocating file: [" + file_path + "]," +
+                        " size: [" + sl::support::to_string(size) + "]," +
+                        " error: [" + ::strerror(err) + "]"));
+            }
+        }
+#else // !STATICLIB_LINUX
+        (void) size;
+#endif // STATICLIB_LINUX
+    }
+
+    void close_file() STATICLIB_NOEXCEPT {
+        if (-1 != fd) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif // STATICLIB_WINDOWS
+};
+
+void create_directory(const std::string& dir_path) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(dir_path);
+    if (0 == ::CreateDirectoryW(wpath.c_str(), NULL)) {
+        auto err = ::GetLastError();
+        if (ERROR_ALREADY_EXISTS != err) throw unzip_exception(TRACEMSG(
+                "Error creating directory: [" + dir_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(err) + "]"));
+    }
+#else // !STATICLIB_WINDOWS
+    if (0 != ::mkdir(dir_path.c_str(), 0755) && EEXIST != errno) throw unzip_exception(TRACEMSG(
+            "Error creating directory: [" + dir_path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+void check_entry_name(const file_index& idx, const std::string& name) {
+    bool invalid = '/' == name.front() || std::string::npos != name.find('\\');
+#ifdef STATICLIB_WINDOWS
+    // drive letters and alternate data streams, colon is a valid file name byte elsewhere
+    invalid = invalid || std::string::npos != name.find(':');
+#endif // STATICLIB_WINDOWS
+    for (size_t start = 0; !invalid && start < name.length();) {
+        size_t end = name.find('/', start);
+        if (std::string::npos == end) {
+            end = name.length();
+        }
+        invalid = 2 == end - start && 0 == name.compare(start, 2, "..");
+        start = end + 1;
+    }
+    if (invalid) throw unzip_exception(TRACEMSG(
+            "Invalid entry name for extraction: [" + name + "]," +
+            " in ZIP file: [" + idx.get_zip_file_path() + "]"));
+}
+
+void write_entry_file(const std::string& dest_dir, const std::string& name, const file_entry& entry,
+        std::istream& stream, std::vector<char>& buf) {
+    sl::io::streambuf_source src{stream.rdbuf()};
+    uint64_t expected = static_cast<uint64_t>(entry.uncomp_length);
+    output_file out{dest_dir + "/" + name, expected};
+    uint64_t written = 0;
+    for (;;) {
+        auto read = sl::io::read_all(src, {buf.data(), buf.size()});
+        if (read <= 0) {
+            break;
+        }
+        sl::io::write_all(out, {buf.data(), static_cast<size_t>(read)});
+        written += static_cast<uint64_t>(read);
+    }
+    if (expected != written) throw unzip_exception(TRACEMSG(
+            "Invalid length of extracted entry: [" + name + "]," +
+            " expected: [" + sl::support::to_string(expected) + "]," +
+            " actual: [" + sl::support::to_string(written) + "]"));
+}
+
+void extract_entry(const file_index& idx, const std::string& dest_dir, const extract_task& task,
+        std::vector<char>& buf) {
+    // bulk extraction bypasses the entry cache
+    auto stream = open_entry_stream(idx, {task.name->data(), task.name->length()}, task.entry);
+    write_entry_file(dest_dir, *task.name, task.entry, *stream, buf);
+}
+
+// extracts the entries in the offset order reading them through the ring
+// in the same groups as "read_entries_batch", returns false if the ring is not available
+bool extract_entries_ring(const file_index& idx, const std::string& dest_dir, const extract_task* tasks,
+        size_t count, const batch_options& options, std::vector<char>& buf) {
+    auto reader = idx.get_archive_reader();
+    std::vector<batch_task> batch;
+    batch.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        auto& task = tasks[i];
+        uint64_t end = static_cast<uint64_t>(task.entry.offset) + local_header_len + task.name->length() +
+                static_cast<uint64_t>(task.entry.comp_length) + local_extra_slack;
+        batch.emplace_back(task.name, task.entry, std::min(end, reader->size()));
+    }
+    auto groups = make_batch_groups(batch, options);
+    // tasks are delivered in order, so the entry of the delivered name is known without a lookup
+    size_t delivered = 0;
+    auto write_fun = [&](const std::string& name, std::istream& stream) {
+        write_entry_file(dest_dir, name, batch[delivered].entry, stream, buf);
+        delivered += 1;
+    };
+    return deliver_groups_ring(idx, batch, groups, reader, options, write_fun);
+}
+
+size_t extract_entries(const file_index& idx, const std::string& dest_dir,
+        const std::function<bool(const std::string&)>& filter, extract_options options) {
+    std::vector<extract_task> tasks;
+    std::set<std::string> dirs;
+    for (auto& name : idx.get_entries()) {
+        // entries with empty names are not indexed as files, same as in "verify_archive"
+        if (name.empty() || (filter && !filter(name))) {
+            continue;
+        }
+        check_entry_name(idx, name);
+        for (size_t pos = name.find('/'); std::string::npos != pos; pos = name.find('/', pos + 1)) {
+            dirs.insert(name.substr(0, pos));
+        }
+        if ('/' != name.back()) {
+            tasks.emplace_back(std::addressof(name), idx.find_zip_entry(name));
+        }
+    }
+
+    // parents are ordered before their children
+    create_directory(dest_dir);
+    for (auto& dir : dirs) {
+        create_directory(dest_dir + "/" + dir);
+    }
+
+    size_t threads_count = options.threads_count > 0 ? options.threads_count :
+            static_cast<size_t>(std::thread::hardware_concurrency());
+    threads_count = std::max(static_cast<size_t>(1), std::min(threads_count, tasks.size()));
+    auto reader = idx.get_archive_reader();
+    bool ring_allowed = options.io_queue_depth > 0 && !idx.is_memory_mapped() && reader->file_descriptor() >= 0;
+
+    // with the ring each worker reads its own contiguous range of entries in the offset order,
+    // ranges are split by compressed length, otherwise largest entries go first
+    // to keep all workers busy till the end
+    std::vector<size_t> ranges;
+    if (ring_allowed) {
+        std::stable_sort(tasks.begin(), tasks.end(), [](const extract_task& a, const extract_task& b) {
+            return a.entry.offset < b.entry.offset;
+        });
+        uint64_t total = 0;
+        for (auto& task : tasks) {
+            total += static_cast<uint64_t>(task.entry.comp_length);
+        }
+        ranges.push_back(0);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            sum += static_cast<uint64_t>(tasks[i].entry.comp_length);
+            if (ranges.size() < threads_count && sum >= total / threads_count * ranges.size()) {
+                ranges.push_back(i + 1);
+            }
+        }
+        ranges.push_back(tasks.size());
+    } else {
+        std::stable_sort(tasks.begin(), tasks.end(), [](const extract_task& a, const extract_task& b) {
+            return a.entry.uncomp_length > b.entry.uncomp_length;
+        });
+    }
+    batch_options batch;
+    batch.io_queue_depth = options.io_queue_depth;
+    batch.io_buffer_budget = std::max(options.io_buffer_budget / threads_count, batch.max_read_size);
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex mtx;
+    std::string error;
+    auto worker = [&] {
+        std::vector<char> buf;
+        buf.resize(extract_buffer_size);
+        while (!failed.load()) {
+            size_t i = next.fetch_add(1);
+            try {
+                if (ring_allowed) {
+                    if (i + 1 >= ranges.size()) {
+                        break;
+                    }
+                    const extract_task* range = tasks.data() + ranges[i];
+                    size_t count = ranges[i + 1] - ranges[i];
+                    if (count > 0 && !extract_entries_ring(idx, dest_dir, range, count, batch, buf)) {
+                        for (size_t j = 0; j < count && !failed.load(); j++) {
+                            extract_entry(idx, dest_dir, range[j], buf);
+                        }
+                    }
+                } else {
+                    if (i >= tasks.size()) {
+                        break;
+                    }
+                    extract_entry(idx, dest_dir, tasks[i], buf);
+                }
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> guard{mtx};
+                if (!failed.load()) {
+                    error = e.what();
+                    failed.store(true);
+                }
+            }
+        }
+    };
+    run_workers(threads_count, worker);
+    if (failed.load()) throw unzip_exception(TRACEMSG(
+            "Error extracting ZIP file: [" + idx.get_zip_file_path() + "]," +
+            " into directory: [" + dest_dir + "]" +
+            "\n" + error));
+    return tasks.size();
+}
+
+template<typename Source>
+bool verify_decoded(Source& src, const file_entry& desc, std::vector<char>& buf, uint64_t& bytes_count) {
+    uint32_t crc = 0;
+    uint64_t len = 0;
+    for (;;) {
+        auto read = sl::io::read_all(src, {buf.data(), buf.size()});
+        if (read <= 0) {
+            break;
+        }
+        crc = crc32_update(crc, buf.data(), static_cast<size_t>(read));
+        len += static_cast<uint64_t>(read);
+    }
+    bytes_count += len;
+    return static_cast<uint64_t>(desc.uncomp_length) == len && desc.crc == crc;
+}
+
+template<sl::compress::zip_compression_method Method, typename Source>
+bool verify_entry_data(Source&& src, const file_entry& desc, std::vector<char>& buf, uint64_t& bytes_count) {
+    auto esrc = typename native_entry_source<Source, Method>::type(
+            std::move(src), static_cast<uint64_t>(desc.uncomp_length));
+    return verify_decoded(esrc, desc, buf, bytes_count);
+}
+
+bool verify_entry(const file_index& idx, const std::shared_ptr<archive_reader>& reader, const file_entry& desc,
+        std::vector<char>& buf, uint64_t& bytes_count) {
+    uint64_t data_offset = find_local_data(reader, desc, idx.get_stats_collector());
+    uint64_t comp_length = static_cast<uint64_t>(desc.comp_length);
+    switch (desc.comp_method) {
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::store):
+        if (comp_length != static_cast<uint64_t>(desc.uncomp_length)) {
+            return false;
+        }
+        if (idx.is_memory_mapped()) {
+            // stored data is checked in place
+            const char* data = reader->data().data() + data_offset;
+            bytes_count += comp_length;
+            return desc.crc == crc32_update(0, data, static_cast<size_t>(comp_length));
+        }
+        return verify_entry_data<sl::compress::zip_compression_method::store>(
+                archive_range_source(reader, data_offset, comp_length), desc, buf, bytes_count);
+    case static_cast<uint16_t>(sl::compress::zip_compression_method::deflate):
+        if (idx.is_memory_mapped()) {
+            return verify_entry_data<sl::compress::zip_compression_method::deflate>(
+                    sl::io::array_source(reader->data().data() + data_offset, static_cast<size_t>(comp_length)),
+                    desc, buf, bytes_count);
+        }
+        return verify_entry_data<sl::compress::zip_compression_method::deflate>(
+                archive_range_source(reader, data_offset, comp_length), desc, buf, bytes_count);
+    default: {
+        auto codec = find_codec(desc.comp_method);
+        if (nullptr == codec.get()) {
+            return false;
+        }
+        std::unique_ptr<codec_source> compressed;
+        if (idx.is_memory_mapped()) {
+            compressed = make_codec_source(sl::io::array_source(reader->data().data() + data_offset,
+                    static_cast<size_t>(comp_length)));
+        } else {
+            compressed = make_codec_source(archive_range_source(reader, data_offset, comp_length));
+        }
+        auto decoder = codec->open_decoder(std::move(compressed), static_cast<uint64_t>(desc.uncomp_length));
+        return verify_decoded(*decoder, desc, buf, bytes_count);
+    }
+    }
+}
+
+std::unique_ptr<std::istream> open_found_entry(const file_index& idx, sl::io::span<const char> entry_name,
+        const file_entry& desc) {
+    auto cache = idx.get_entry_cache();
+    bool direct = idx.is_memory_mapped() &&
+            static_cast<uint16_t>(sl::compress::zip_compression_method::store) == desc.comp_method;
+    if (nullptr != cache.get() && !direct &&
+            static_cast<uint64_t>(desc.uncomp_length) <= cache->get_entry_max_size()) {
+        auto data = cache->get(static_cast<uint64_t>(desc.offset));
+        if (nullptr == data.get()) {
+            data = cache->put(static_cast<uint64_t>(desc.offset), read_entry_data(idx, entry_name, desc));
+        } else {
+            auto stats = idx.get_stats_collector();
+            if (nullptr != stats.get()) {
+                stats->record_open(desc.comp_method);
+            }
+        }
+        return std::unique_ptr<std::istream>(new cached_entry_istream(std::move(data)));
+    }
+    return open_entry_stream(idx, entry_name, desc);
+}
+
+template<typename Open>
+std::unique_ptr<std::istream> open_with_latency(const file_index& idx, Open open) {
+    auto stats = idx.get_stats_collector();
+    if (nullptr == stats.get()) {
+        return open();
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto res = open();
+    stats->record_open_latency(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    return res;
+}
+
 } // namespace
 
 std::unique_ptr<std::istream> open_zip_entry(const file_index& idx, const std::string& entry_name) {
+    return open_with_latency(idx, [&idx, &entry_name] {
+        return open_found_entry(idx, {entry_name.data(), entry_name.length()}, find_entry_checked(idx, entry_name));
+    });
+}
+
+std::unique_ptr<std::istream> open_zip_entry(const file_index& idx, uint32_t entry_id) {
+    return open_with_latency(idx, [&idx, entry_id] {
+        auto desc = idx.get_zip_entry(entry_id);
+        // name is only used for error reporting
+        return open_found_entry(idx, idx.get_entry_name(entry_id), desc);
+    });
+}
+
+std::unique_ptr<std::istream> open_zip_entry(const overlay_index& overlay, const std::string& entry_name) {
+    auto found = overlay.find_entry(entry_name);
+    if (found.is_empty()) throw unzip_exception(TRACEMSG(
+            "Specified zip entry not found: [" + entry_name + "]," +
+            " layers count: [" + sl::support::to_string(overlay.get_layers_count()) + "]"));
+    const file_index& idx = overlay.get_layer(found.layer);
+    return open_with_latency(idx, [&idx, &entry_name, &found] {
+        return open_found_entry(idx, {entry_name.data(), entry_name.length()}, found.entry);
+    });
+}
+
+std::unique_ptr<std::istream> open_zip_entry(entry_prefetcher& prefetcher, const std::string& entry_name) {
+    auto data = prefetcher.take(entry_name);
+    if (nullptr != data.get()) {
+        return std::unique_ptr<std::istream>(new cached_entry_istream(std::move(data)));
+    }
+    return open_zip_entry(prefetcher.get_index(), entry_name);
+}
+
+sl::io::span<const char> view_zip_entry(const file_index& idx, const std::string& entry_name) {
     auto desc = idx.find_zip_entry(entry_name);
     if (-1 == desc.offset) throw unzip_exception(TRACEMSG(
             "Specified zip entry not found: [" + entry_name + "]"));
-    try {
-        auto src = sl::io::make_unique_source(new unzip_entry_source(idx.get_zip_file_path(), entry_name, desc));
-        return sl::io::make_source_istream_ptr(std::move(src));
-    } catch (const std::exception& e) {
+    if (!idx.is_memory_mapped()) throw unzip_exception(TRACEMSG(
+            "Cannot view zip entry: [" + entry_name + "]," +
+            " zip file: [" + idx.get_zip_file_path() + "] is not memory-mapped"));
+    if (static_cast<uint16_t>(sl::compress::zip_compression_method::store) != desc.comp_method) {
         throw unzip_exception(TRACEMSG(
-                "Error opening zip entry: [" + entry_name + "]" +
-                " from zip file: [" + idx.get_zip_file_path() + "]" +
-                " with offset: [" + sl::support::to_string(desc.offset) + "]," +
-                " length: [" + sl::support::to_string(desc.comp_length) + "]" +
-                "\n" + e.what()));
+                "Cannot view compressed zip entry: [" + entry_name + "]," +
+                " compression method: [" + sl::support::to_string(desc.comp_method) + "]," +
+                " zip file: [" + idx.get_zip_file_path() + "]"));
     }
+    auto reader = idx.get_archive_reader();
+    uint64_t data_offset = find_data_offset(reader, desc);
+    return sl::io::span<const char>(reader->data().data() + data_offset, static_cast<size_t>(desc.comp_length));
+}
+
+file_index open_nested_index(const file_index& outer, const std::string& entry_name,
+        file_index_options options) {
+    auto desc = find_entry_checked(outer, entry_name);
+    std::string nested_path = outer.get_zip_file_path() + "/" + entry_name;
+    if (static_cast<uint16_t>(sl::compress::zip_compression_method::store) == desc.comp_method &&
+            desc.comp_length == desc.uncomp_length) {
+        auto reader = outer.get_archive_reader();
+        uint64_t data_offset = find_local_data(reader, desc, outer.get_stats_collector());
+        auto range = make_range_reader(std::move(reader), data_offset, static_cast<uint64_t>(desc.comp_length),
+                std::move(nested_path));
+        return file_index(std::move(range), std::move(options));
+    }
+    // compressed archives are inflated once and held by the nested reader
+    auto data = std::make_shared<std::vector<char>>(read_entry(outer, entry_name));
+    auto memory = make_memory_reader(std::shared_ptr<const std::vector<char>>(std::move(data)),
+            std::move(nested_path));
+    return file_index(std::move(memory), std::move(options));
+}
+
+sl::io::span<const char> view_zip_entry_data(const file_index& idx, const std::string& entry_name) {
+    auto desc = find_entry_checked(idx, entry_name);
+    if (!idx.is_memory_mapped()) throw unzip_exception(TRACEMSG(
+            "Cannot view zip entry data: [" + entry_name + "]," +
+            " zip file: [" + idx.get_zip_file_path() + "] is not memory-mapped"));
+    auto reader = idx.get_archive_reader();
+    uint64_t data_offset = find_local_data(reader, desc, idx.get_stats_collector());
+    return sl::io::span<const char>(reader->data().data() + data_offset, static_cast<size_t>(desc.comp_length));
+}
+
+archive_range_source open_zip_entry_data(const file_index& idx, const std::string& entry_name) {
+    auto desc = find_entry_checked(idx, entry_name);
+    auto reader = idx.get_archive_reader();
+    uint64_t data_offset = find_local_data(reader, desc, idx.get_stats_collector());
+    return archive_range_source(std::move(reader), data_offset, static_cast<uint64_t>(desc.comp_length));
+}
+
+size_t read_entry_into(const file_index& idx, const std::string& entry_name, sl::io::span<char> buffer) {
+    auto desc = find_entry_checked(idx, entry_name);
+    uint64_t len = static_cast<uint64_t>(desc.uncomp_length);
+    if (len > buffer.size()) throw unzip_exception(TRACEMSG(
+            "Buffer is too small for zip entry: [" + entry_name + "]," +
+            " entry length: [" + sl::support::to_string(len) + "]," +
+            " buffer length: [" + sl::support::to_string(buffer.size()) + "]"));
+    read_entry_cached(idx, {entry_name.data(), entry_name.length()}, desc, buffer.data());
+    return static_cast<size_t>(len);
+}
+
+std::vector<char> read_entry(const file_index& idx, const std::string& entry_name) {
+    auto desc = find_entry_checked(idx, entry_name);
+    std::vector<char> res;
+    res.resize(static_cast<size_t>(desc.uncomp_length));
+    read_entry_cached(idx, {entry_name.data(), entry_name.length()}, desc, res.data());
+    return res;
+}
+
+verify_result verify_archive(const file_index& idx, verify_options options) {
+    auto reader = idx.get_archive_reader();
+    std::vector<extract_task> tasks;
+    for (auto& name : idx.get_entries()) {
+        // entries with empty names are not indexed as files, same as directories
+        if (!name.empty() && '/' != name.back()) {
+            tasks.emplace_back(std::addressof(name), idx.find_zip_entry(name));
+        }
+    }
+    std::stable_sort(tasks.begin(), tasks.end(), [](const extract_task& a, const extract_task& b) {
+        return a.entry.uncomp_length > b.entry.uncomp_length;
+    });
+
+    size_t threads_count = options.threads_count > 0 ? options.threads_count :
+            static_cast<size_t>(std::thread::hardware_concurrency());
+    threads_count = std::max(static_cast<size_t>(1), std::min(threads_count, tasks.size()));
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> bytes_total{0};
+    std::atomic<bool> failed{false};
+    std::mutex mtx;
+    std::exception_ptr error;
+    verify_result res;
+    auto worker = [&] {
+        try {
+            std::vector<char> buf;
+            buf.resize(extract_buffer_size);
+            uint64_t bytes_count = 0;
+            while (!failed.load()) {
+                size_t i = next.fetch_add(1);
+                if (i >= tasks.size()) {
+                    break;
+                }
+                bool valid = false;
+                try {
+                    valid = verify_entry(idx, reader, tasks[i].entry, buf, bytes_count);
+                } catch (const sl::support::exception&) {
+                    // invalid headers and data (unzip, inflate and codec errors) are reported as failed entries
+                }
+                if (!valid) {
+                    std::lock_guard<std::mutex> guard{mtx};
+                    res.failed_entries.push_back(*tasks[i].name);
+                }
+            }
+            bytes_total.fetch_add(bytes_count);
+        } catch (...) {
+            // other errors (allocation, system) are not entry failures, first one is rethrown
+            std::lock_guard<std::mutex> guard{mtx};
+            if (!failed.load()) {
+                error = std::current_exception();
+                failed.store(true);
+            }
+        }
+    };
+    run_workers(threads_count, worker);
+    if (failed.load()) {
+        std::rethrow_exception(error);
+    }
+    std::sort(res.failed_entries.begin(), res.failed_entries.end());
+    res.entries_count = tasks.size();
+    res.bytes_count = bytes_total.load();
+    return res;
+}
+
+size_t read_entries_batch(const file_index& idx, const std::vector<std::string>& entry_names,
+        std::function<void(const std::string&, std::istream&)> callback, batch_options options) {
+    auto reader = idx.get_archive_reader();
+    std::vector<batch_task> tasks;
+    tasks.reserve(entry_names.size());
+    for (auto& name : entry_names) {
+        auto desc = idx.find_zip_entry(name);
+        if (-1 == desc.offset) throw unzip_exception(TRACEMSG(
+                "Specified zip entry not found: [" + name + "]"));
+        uint64_t end = static_cast<uint64_t>(desc.offset) + local_header_len + name.length() +
+                static_cast<uint64_t>(desc.comp_length) + local_extra_slack;
+        tasks.emplace_back(std::addressof(name), desc, std::min(end, reader->size()));
+    }
+    std::stable_sort(tasks.begin(), tasks.end(), [](const batch_task& a, const batch_task& b) {
+        return a.entry.offset < b.entry.offset;
+    });
+    if (idx.is_memory_mapped()) {
+        // mapping is already in memory, only the access order matters
+        for (auto& task : tasks) {
+            auto stream = open_entry_stream(idx, {task.name->data(), task.name->length()}, task.entry);
+            callback(*task.name, *stream);
+        }
+        return tasks.size();
+    }
+    auto groups = make_batch_groups(tasks, options);
+    if (options.io_queue_depth > 0 && reader->file_descriptor() >= 0 &&
+            deliver_groups_ring(idx, tasks, groups, reader, options, callback)) {
+        return tasks.size();
+    }
+    std::vector<char> buf;
+    for (auto& gr : groups) {
+        if (gr.streamed) {
+            deliver_streamed(idx, tasks[gr.first], callback);
+            continue;
+        }
+        if (buf.size() < gr.len) {
+            buf.resize(gr.len);
+        }
+        auto src = archive_range_source(reader, gr.start, gr.len);
+        auto read = sl::io::read_all(src, {buf.data(), gr.len});
+        size_t buf_len = read > 0 ? static_cast<size_t>(read) : 0;
+        for (size_t i = gr.first; i < gr.last; i++) {
+            deliver_entry(idx, tasks[i], reader, buf, gr.start, buf_len, callback);
+        }
+    }
+    return tasks.size();
+}
+
+size_t extract_all(const file_index& idx, const std::string& dest_dir, extract_options options) {
+    return extract_entries(idx, dest_dir, nullptr, options);
+}
+
+size_t extract_matching(const file_index& idx, const std::string& dest_dir,
+        std::function<bool(const std::string&)> filter, extract_options options) {
+    return extract_entries(idx, dest_dir, filter, options);
 }
 
 } // namespace
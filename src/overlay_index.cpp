@@ -0,0 +1,169 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   overlay_index.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:20 AM
+ */
+
+#include "staticlib/unzip/overlay_index.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "staticlib/config.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/pimpl/forward_macros.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "entry_table.hpp"
+#include "name_index.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+class overlay_index::impl : public sl::pimpl::object::impl {
+    std::vector<file_index> layers;
+    entry_table table;
+    // layer position and layer entry id for each merged record
+    std::vector<std::pair<uint32_t, uint32_t>> origins;
+    name_index sorted;
+
+public:
+    ~impl() STATICLIB_NOEXCEPT { };
+
+    template<typename Layers>
+    impl(Layers&& layers) :
+    layers(std::forward<Layers>(layers)) {
+        // directories are not hashed by the table, they are deduplicated separately
+        std::unordered_set<std::string> dirs;
+        for (size_t i = 0; i < this->layers.size(); i++) {
+            const file_index& layer = this->layers[i];
+            size_t count = layer.get_entries_count();
+            for (uint32_t id = 0; id < count; id++) {
+                auto name = layer.get_entry_name(id);
+                bool is_file = name.size() > 0 && '/' != name.data()[name.size() - 1];
+                if (!is_file && !dirs.emplace(name.data(), name.size()).second) {
+                    continue;
+                }
+                size_t count_before = table.size();
+                table.add(name.data(), name.size(), layer.get_zip_entry(id));
+                if (table.size() > count_before) {
+                    origins.emplace_back(static_cast<uint32_t>(i), id);
+                }
+            }
+        }
+        sorted.build(table);
+    }
+
+    overlay_entry find_entry(const overlay_index&, const std::string& name) const {
+        return resolve(name.data(), name.length());
+    }
+
+    overlay_entry find_entry(const overlay_index&, const char* name, size_t name_len) const {
+        return resolve(name, name_len);
+    }
+
+    size_t get_layers_count(const overlay_index&) const {
+        return layers.size();
+    }
+
+    const file_index& get_layer(const overlay_index&, size_t layer) const {
+        if (layer >= layers.size()) throw unzip_exception(TRACEMSG(
+                "Invalid layer: [" + sl::support::to_string(layer) + "]," +
+                " layers count: [" + sl::support::to_string(layers.size()) + "]"));
+        return layers[layer];
+    }
+
+    size_t get_entries_count(const overlay_index&) const {
+        return table.size();
+    }
+
+    overlay_entry get_entry(const overlay_index&, uint32_t id) const {
+        check_id(id);
+        return entry_at(id);
+    }
+
+    sl::io::span<const char> get_entry_name(const overlay_index&, uint32_t id) const {
+        check_id(id);
+        return sl::io::span<const char>(table.name_data(id), table.name_len(id));
+    }
+
+    sl::io::span<const uint32_t> list_prefix(const overlay_index&, const std::string& prefix) const {
+        return sorted.prefix(table, prefix.data(), prefix.length());
+    }
+
+    std::vector<sl::io::span<const char>> list_directory(const overlay_index&, const std::string& dir) const {
+        std::string prefix = dir;
+        if (!prefix.empty() && '/' != prefix.back()) {
+            prefix.push_back('/');
+        }
+        std::vector<sl::io::span<const char>> res;
+        sorted.children(table, prefix.data(), prefix.length(), res);
+        return res;
+    }
+
+    std::vector<uint32_t> list_glob(const overlay_index&, const std::string& pattern) const {
+        std::vector<uint32_t> res;
+        sorted.glob(table, pattern.data(), pattern.length(), res);
+        return res;
+    }
+
+private:
+    overlay_entry resolve(const char* name, size_t name_len) const {
+        uint32_t id = table.find(name, name_len);
+        if (entry_table::not_found == id) {
+            return overlay_entry();
+        }
+        return entry_at(id);
+    }
+
+    overlay_entry entry_at(uint32_t id) const {
+        overlay_entry res;
+        res.layer = static_cast<size_t>(origins[id].first);
+        res.id = origins[id].second;
+        res.entry = table.entry(id);
+        return res;
+    }
+
+    void check_id(uint32_t id) const {
+        if (id >= table.size()) throw unzip_exception(TRACEMSG(
+                "Invalid overlay entry id: [" + sl::support::to_string(id) + "]," +
+                " entries count: [" + sl::support::to_string(table.size()) + "]"));
+    }
+};
+// layers are moved into the impl, forwarding constructor would pass them as lvalue
+overlay_index::overlay_index(std::vector<file_index> layers) :
+sl::pimpl::object(nullptr, std::unique_ptr<sl::pimpl::object::impl>(
+        new overlay_index::impl(std::move(layers)))) { }
+
+PIMPL_FORWARD_METHOD(overlay_index, overlay_entry, find_entry, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, overlay_entry, find_entry, (const char*)(size_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, size_t, get_layers_count, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, const file_index&, get_layer, (size_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, size_t, get_entries_count, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, overlay_entry, get_entry, (uint32_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, sl::io::span<const char>, get_entry_name, (uint32_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, sl::io::span<const uint32_t>, list_prefix, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, std::vector<sl::io::span<const char>>, list_directory, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(overlay_index, std::vector<uint32_t>, list_glob, (const std::string&), (const), unzip_exception)
+
+} // namespace
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   run_workers.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:10 AM
+ */
+
+#ifndef STATICLIB_UNZIP_RUN_WORKERS_HPP
+#define STATICLIB_UNZIP_RUN_WORKERS_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Runs the specified worker function on the calling thread and on "count - 1"
+ * additional threads, returns when all of them are finished. If a thread
+ * cannot be started, already started threads are joined before the error
+ * is rethrown, so workers taking tasks from a shared queue finish them.
+ *
+ * @param count total number of workers, including the calling thread
+ * @param fn worker function, must not throw
+ * @throws std::system_error if a thread cannot be started
+ */
+template<typename Fun>
+void run_workers(size_t count, Fun fn) {
+    std::vector<std::thread> threads;
+    try {
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back(fn);
+        }
+    } catch (...) {
+        for (auto& th : threads) {
+            th.join();
+        }
+        throw;
+    }
+    fn();
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_RUN_WORKERS_HPP */
@@ -0,0 +1,438 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   seekable_entry.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 7:48 PM
+ */
+
+#include "staticlib/unzip/operations.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <streambuf>
+#include <vector>
+
+#include "zlib.h"
+
+#include "staticlib/compress.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "local_header.hpp"
+#include "zip_format.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const size_t window_size = 1 << 15;
+const size_t in_buffer_size = 1 << 14;
+const size_t out_buffer_size = 1 << 16;
+
+/**
+ * Seekable buffer over the entry data, stored entries are read directly
+ * from the requested position, deflated entries are inflated starting from
+ * the nearest preceding checkpoint, new checkpoints are recorded on
+ * block boundaries while the entry is inflated sequentially
+ */
+class seekable_entry_streambuf : public std::streambuf {
+    std::shared_ptr<archive_reader> reader;
+    std::string zip_entry_name;
+    uint64_t data_offset;
+    uint64_t comp_length;
+    uint64_t uncomp_length;
+    bool deflate;
+    std::shared_ptr<inflate_checkpoints> checkpoints;
+    std::shared_ptr<index_stats> stats;
+
+    z_stream strm;
+    bool strm_active = false;
+    bool strm_finished = false;
+    bool record = false;
+    uint64_t next_checkpoint = 0;
+    // compressed position of the next input read
+    uint64_t in_pos = 0;
+    // uncompressed position of the next produced byte
+    uint64_t stream_pos = 0;
+    // uncompressed position of the start of the get area
+    uint64_t area_start = 0;
+    std::vector<char> in_buf;
+    std::vector<char> out_buf;
+    // last 32 KiB of the uncompressed data, only kept while recording checkpoints
+    std::vector<char> history;
+    size_t history_end = 0;
+    size_t history_len = 0;
+
+public:
+    seekable_entry_streambuf(std::shared_ptr<archive_reader> reader, const std::string& zip_entry_name,
+            const file_entry& entry, uint64_t data_offset, std::shared_ptr<inflate_checkpoints> checkpoints,
+            std::shared_ptr<index_stats> stats) :
+    reader(std::move(reader)),
+    zip_entry_name(zip_entry_name.data(), zip_entry_name.length()),
+    data_offset(data_offset),
+    comp_length(static_cast<uint64_t>(entry.comp_length)),
+    uncomp_length(static_cast<uint64_t>(entry.uncomp_length)),
+    deflate(static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) == entry.comp_method),
+    checkpoints(std::move(checkpoints)),
+    stats(std::move(stats)) {
+        if (!deflate && static_cast<uint16_t>(sl::compress::zip_compression_method::store) != entry.comp_method) {
+            throw unzip_exception(TRACEMSG(
+                    "Unsupported compression method: [" + sl::support::to_string(entry.comp_method) + "],"
+                    " in entry: [" + this->zip_entry_name + "],"
+                    " in ZIP file: [" + this->reader->path() + "]"));
+        }
+        if (!deflate && comp_length != uncomp_length) throw unzip_exception(TRACEMSG(
+                "Invalid stored entry: [" + this->zip_entry_name + "],"
+                " compressed length: [" + sl::support::to_string(comp_length) + "],"
+                " uncompressed length: [" + sl::support::to_string(uncomp_length) + "],"
+                " in ZIP file: [" + this->reader->path() + "]"));
+        out_buf.resize(out_buffer_size);
+        setg(out_buf.data(), out_buf.data(), out_buf.data());
+        if (deflate) {
+            std::memset(std::addressof(strm), '\0', sizeof(strm));
+            if (Z_OK != ::inflateInit2(std::addressof(strm), -MAX_WBITS)) throw unzip_exception(TRACEMSG(
+                    "Inflate initialization error, entry: [" + this->zip_entry_name + "]"));
+            strm_active = true;
+            if (0 == this->reader->data().size()) {
+                in_buf.resize(in_buffer_size);
+            }
+            restart(nullptr);
+        }
+    }
+
+    seekable_entry_streambuf(const seekable_entry_streambuf&) = delete;
+
+    seekable_entry_streambuf& operator=(const seekable_entry_streambuf&) = delete;
+
+    ~seekable_entry_streambuf() STATICLIB_NOEXCEPT {
+        if (strm_active) {
+            ::inflateEnd(std::addressof(strm));
+        }
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        area_start = stream_pos;
+        size_t len = available(out_buf.size());
+        size_t read = len > 0 ? produce(out_buf.data(), len) : 0;
+        setg(out_buf.data(), out_buf.data(), out_buf.data() + read);
+        if (0 == read) {
+            return traits_type::eof();
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streamsize showmanyc() override {
+        uint64_t pos = area_start + static_cast<uint64_t>(gptr() - eback());
+        return pos < uncomp_length ? static_cast<std::streamsize>(std::min(uncomp_length - pos,
+                static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()))) : -1;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (0 == (which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        int64_t base = 0;
+        switch (dir) {
+        case std::ios_base::beg: base = 0; break;
+        case std::ios_base::cur: base = static_cast<int64_t>(area_start) + (gptr() - eback()); break;
+        case std::ios_base::end: base = static_cast<int64_t>(uncomp_length); break;
+        default: return pos_type(off_type(-1));
+        }
+        int64_t target = base + static_cast<int64_t>(off);
+        if (target < 0 || static_cast<uint64_t>(target) > uncomp_length) {
+            return pos_type(off_type(-1));
+        }
+        seek_to(static_cast<uint64_t>(target));
+        return pos_type(static_cast<off_type>(target));
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    size_t available(size_t len) {
+        uint64_t avail = uncomp_length > stream_pos ? uncomp_length - stream_pos : 0;
+        return len <= avail ? len : static_cast<size_t>(avail);
+    }
+
+    void seek_to(uint64_t target) {
+        // target is inside of the current get area
+        if (target >= area_start && target <= area_start + static_cast<uint64_t>(egptr() - eback())) {
+            setg(eback(), eback() + (target - area_start), egptr());
+            return;
+        }
+        if (deflate) {
+            inflate_checkpoint point;
+            bool found = checkpoints->find(target, point);
+            if (target < stream_pos || (found && point.out_pos > stream_pos)) {
+                restart(found ? std::addressof(point) : nullptr);
+            }
+            while (stream_pos < target) {
+                uint64_t avail = target - stream_pos;
+                size_t len = out_buf.size() <= avail ? out_buf.size() : static_cast<size_t>(avail);
+                if (0 == produce(out_buf.data(), len)) {
+                    break;
+                }
+            }
+        } else {
+            stream_pos = target;
+        }
+        area_start = stream_pos;
+        setg(out_buf.data(), out_buf.data(), out_buf.data());
+    }
+
+    size_t produce(char* dest, size_t len) {
+        if (!deflate) {
+            std::streamsize read = reader->read_at(data_offset + stream_pos, {dest, len});
+            if (read <= 0) throw unzip_exception(TRACEMSG(
+                    "Unexpected end of data, entry: [" + zip_entry_name + "],"
+                    " position: [" + sl::support::to_string(stream_pos) + "],"
+                    " in ZIP file: [" + reader->path() + "]"));
+            stream_pos += static_cast<uint64_t>(read);
+            if (nullptr != stats.get()) {
+                stats->record_read(static_cast<uint64_t>(read), static_cast<uint64_t>(read));
+            }
+            return static_cast<size_t>(read);
+        }
+        if (nullptr == stats.get()) {
+            return inflate_data(dest, len);
+        }
+        auto start = std::chrono::steady_clock::now();
+        size_t res = inflate_data(dest, len);
+        stats->record_inflate_time(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+        stats->record_read(0, res);
+        return res;
+    }
+
+    size_t inflate_data(char* dest, size_t len) {
+        strm.next_out = reinterpret_cast<Bytef*>(dest);
+        strm.avail_out = static_cast<uInt>(len);
+        while (strm.avail_out > 0 && !strm_finished) {
+            if (0 == strm.avail_in && !fill_input()) throw unzip_exception(TRACEMSG(
+                    "Unexpected end of compressed data, entry: [" + zip_entry_name + "],"
+                    " in ZIP file: [" + reader->path() + "]"));
+            Bytef* out_start = strm.next_out;
+            // Z_BLOCK stops on the block boundaries where the checkpoints can be taken
+            int err = ::inflate(std::addressof(strm), record ? Z_BLOCK : Z_NO_FLUSH);
+            size_t produced = static_cast<size_t>(strm.next_out - out_start);
+            stream_pos += produced;
+            if (record) {
+                append_history(reinterpret_cast<const char*>(out_start), produced);
+            }
+            if (Z_STREAM_END == err) {
+                strm_finished = true;
+            } else if (Z_OK != err && Z_BUF_ERROR != err) {
+                throw unzip_exception(TRACEMSG(
+                        "Inflate error: [" + sl::support::to_string(err) + "]," +
+                        " message: [" + (nullptr != strm.msg ? std::string(strm.msg) : std::string()) + "]," +
+                        " entry: [" + zip_entry_name + "],"
+                        " in ZIP file: [" + reader->path() + "]"));
+            } else if (record && stream_pos >= next_checkpoint &&
+                    0 != (strm.data_type & 128) && 0 == (strm.data_type & 64)) {
+                add_checkpoint();
+            }
+        }
+        if (record && (strm_finished || stream_pos >= uncomp_length)) {
+            checkpoints->set_complete();
+            record = false;
+        }
+        return len - strm.avail_out;
+    }
+
+    bool fill_input() {
+        if (in_pos >= comp_length) {
+            return false;
+        }
+        auto data = reader->data();
+        if (data.size() > 0) {
+            // memory-mapped archive is inflated in-place
+            size_t len = static_cast<size_t>(std::min(comp_length - in_pos, static_cast<uint64_t>(inflate_chunk_max)));
+            strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + data_offset + in_pos));
+            strm.avail_in = static_cast<uInt>(len);
+            in_pos += len;
+            record_input(len);
+            return true;
+        }
+        size_t len = static_cast<size_t>(std::min(comp_length - in_pos, static_cast<uint64_t>(in_buf.size())));
+        std::streamsize read = reader->read_at(data_offset + in_pos, {in_buf.data(), len});
+        if (read <= 0) {
+            return false;
+        }
+        strm.next_in = reinterpret_cast<Bytef*>(in_buf.data());
+        strm.avail_in = static_cast<uInt>(read);
+        in_pos += static_cast<uint64_t>(read);
+        record_input(static_cast<size_t>(read));
+        return true;
+    }
+
+    void record_input(size_t len) {
+        if (nullptr != stats.get()) {
+            stats->record_read(static_cast<uint64_t>(len), 0);
+        }
+    }
+
+    void restart(const inflate_checkpoint* point) {
+        if (Z_OK != ::inflateReset(std::addressof(strm))) throw unzip_exception(TRACEMSG(
+                "Inflate reset error, entry: [" + zip_entry_name + "]"));
+        strm.next_in = nullptr;
+        strm.avail_in = 0;
+        strm_finished = false;
+        history_end = 0;
+        history_len = 0;
+        if (nullptr == point) {
+            in_pos = 0;
+            stream_pos = 0;
+        } else {
+            // restore the bit position and the window like "zran" does
+            in_pos = point->in_pos - (point->bits > 0 ? 1 : 0);
+            stream_pos = point->out_pos;
+            if (point->bits > 0) {
+                if (!fill_input()) throw unzip_exception(TRACEMSG(
+                        "Invalid checkpoint, entry: [" + zip_entry_name + "],"
+                        " position: [" + sl::support::to_string(point->out_pos) + "]"));
+                int byte = *strm.next_in;
+                strm.next_in += 1;
+                strm.avail_in -= 1;
+                ::inflatePrime(std::addressof(strm), point->bits, byte >> (8 - point->bits));
+            }
+            if (!point->window.empty()) {
+                ::inflateSetDictionary(std::addressof(strm), reinterpret_cast<const Bytef*>(point->window.data()),
+                        static_cast<uInt>(point->window.size()));
+            }
+        }
+        record = !checkpoints->is_complete();
+        if (record) {
+            history.resize(window_size);
+            if (nullptr != point) {
+                append_history(point->window.data(), point->window.size());
+            }
+            next_checkpoint = checkpoints->last_position() + checkpoints->get_interval();
+        }
+    }
+
+    void add_checkpoint() {
+        inflate_checkpoint point;
+        point.out_pos = stream_pos;
+        point.in_pos = in_pos - strm.avail_in;
+        point.bits = strm.data_type & 7;
+        point.window.resize(history_len);
+        size_t head = history_len < window_size ? 0 : history_end;
+        size_t first = std::min(history_len, window_size - head);
+        std::memcpy(point.window.data(), history.data() + head, first);
+        std::memcpy(point.window.data() + first, history.data(), history_len - first);
+        checkpoints->add(std::move(point));
+        next_checkpoint = checkpoints->last_position() + checkpoints->get_interval();
+    }
+
+    void append_history(const char* data, size_t len) {
+        if (len >= window_size) {
+            std::memcpy(history.data(), data + len - window_size, window_size);
+            history_end = 0;
+            history_len = window_size;
+            return;
+        }
+        size_t first = std::min(len, window_size - history_end);
+        std::memcpy(history.data() + history_end, data, first);
+        std::memcpy(history.data(), data + first, len - first);
+        history_end = (history_end + len) % window_size;
+        history_len = std::min(history_len + len, window_size);
+    }
+};
+
+class seekable_entry_istream : public std::istream {
+    seekable_entry_streambuf buf;
+
+public:
+    seekable_entry_istream(std::shared_ptr<archive_reader> reader, const std::string& zip_entry_name,
+            const file_entry& entry, uint64_t data_offset, std::shared_ptr<inflate_checkpoints> checkpoints,
+            std::shared_ptr<index_stats> stats) :
+    std::istream(nullptr),
+    buf(std::move(reader), zip_entry_name, entry, data_offset, std::move(checkpoints), std::move(stats)) {
+        rdbuf(std::addressof(buf));
+    }
+};
+
+} // namespace
+
+std::unique_ptr<std::istream> open_zip_entry_seekable(const file_index& idx, const std::string& entry_name,
+        std::shared_ptr<inflate_checkpoints> checkpoints) {
+    auto desc = idx.find_zip_entry(entry_name);
+    if (-1 == desc.offset) throw unzip_exception(TRACEMSG(
+            "Specified zip entry not found: [" + entry_name + "]"));
+    try {
+        auto reader = idx.get_archive_reader();
+        auto stats = idx.get_stats_collector();
+        uint64_t data_offset = 0;
+        try {
+            data_offset = find_data_offset(reader, desc);
+        } catch (const std::exception&) {
+            if (nullptr != stats.get()) {
+                stats->record_local_header_failure();
+            }
+            throw;
+        }
+        if (nullptr == checkpoints.get()) {
+            checkpoints = std::make_shared<inflate_checkpoints>();
+        }
+        if (nullptr != stats.get()) {
+            stats->record_open(desc.comp_method);
+        }
+        return std::unique_ptr<std::istream>(new seekable_entry_istream(std::move(reader), entry_name,
+                desc, data_offset, std::move(checkpoints), std::move(stats)));
+    } catch (const std::exception& e) {
+        throw unzip_exception(TRACEMSG(
+                "Error opening zip entry: [" + entry_name + "]" +
+                " from zip file: [" + idx.get_zip_file_path() + "]" +
+                " with offset: [" + sl::support::to_string(desc.offset) + "]," +
+                " length: [" + sl::support::to_string(desc.comp_length) + "]" +
+                "\n" + e.what()));
+    }
+}
+
+std::shared_ptr<inflate_checkpoints> build_inflate_checkpoints(const file_index& idx,
+        const std::string& entry_name, uint64_t interval) {
+    auto desc = idx.find_zip_entry(entry_name);
+    if (-1 == desc.offset) throw unzip_exception(TRACEMSG(
+            "Specified zip entry not found: [" + entry_name + "]"));
+    auto checkpoints = std::make_shared<inflate_checkpoints>(interval);
+    if (static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) != desc.comp_method) {
+        // stored entries are seeked directly
+        checkpoints->set_complete();
+        return checkpoints;
+    }
+    auto stream = open_zip_entry_seekable(idx, entry_name, checkpoints);
+    stream->seekg(0, std::ios_base::end);
+    if (!stream->good()) throw unzip_exception(TRACEMSG(
+            "Error inflating zip entry: [" + entry_name + "]" +
+            " from zip file: [" + idx.get_zip_file_path() + "]"));
+    return checkpoints;
+}
+
+} // namespace
+}
@@ -0,0 +1,544 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   stream_reader.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:25 AM
+ */
+
+#include "staticlib/unzip/stream_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "zlib.h"
+
+#include "staticlib/compress.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "crc32.hpp"
+#include "local_header.hpp"
+#include "zip_format.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+const uint32_t local_header_signature = 0x04034b50;
+const uint32_t data_descriptor_signature = 0x08074b50;
+const uint32_t cd_header_signature = 0x02014b50;
+const uint32_t eocd_signature = 0x06054b50;
+const uint32_t zip64_eocd_signature = 0x06064b50;
+const uint16_t encrypted_flag = 1;
+const size_t min_buffer_size = 4096;
+// blocking reads of the input stream are kept short, so entries are passed on as soon as they arrive
+const size_t istream_read_max = 4096;
+
+// read-ahead buffer over the forward-only source, data is consumed
+// only as far as it is parsed, so nothing is read twice
+class stream_input {
+    codec_source& src;
+    std::vector<char> buf;
+    size_t pos = 0;
+    size_t len = 0;
+    uint64_t position = 0;
+    bool eof = false;
+
+public:
+    stream_input(codec_source& src, size_t buffer_size) :
+    src(src) {
+        buf.resize(std::max(buffer_size, min_buffer_size));
+    }
+
+    stream_input(const stream_input&) = delete;
+
+    stream_input& operator=(const stream_input&) = delete;
+
+    const char* data() const {
+        return buf.data() + pos;
+    }
+
+    size_t avail() const {
+        return len - pos;
+    }
+
+    uint64_t get_position() const {
+        return position;
+    }
+
+    void consume(size_t count) {
+        pos += count;
+        position += count;
+    }
+
+    bool fill() {
+        if (eof) {
+            return false;
+        }
+        if (pos == len) {
+            pos = 0;
+            len = 0;
+        } else if (len == buf.size()) {
+            std::memmove(buf.data(), buf.data() + pos, len - pos);
+            len -= pos;
+            pos = 0;
+            if (len == buf.size()) {
+                buf.resize(buf.size() * 2);
+            }
+        }
+        std::streamsize res = src.read({buf.data() + len, buf.size() - len});
+        if (res <= 0) {
+            eof = true;
+            return false;
+        }
+        len += static_cast<size_t>(res);
+        return true;
+    }
+
+    bool ensure(size_t count) {
+        while (avail() < count) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::streamsize read(sl::io::span<char> span) {
+        if (0 == avail()) {
+            if (span.size() >= buf.size() && !eof) {
+                // large reads bypass the buffer
+                std::streamsize res = src.read(span);
+                if (res <= 0) {
+                    eof = true;
+                    return std::char_traits<char>::eof();
+                }
+                position += static_cast<uint64_t>(res);
+                return res;
+            }
+            if (!fill()) {
+                return std::char_traits<char>::eof();
+            }
+        }
+        size_t count = std::min(span.size(), avail());
+        std::memcpy(span.data(), data(), count);
+        consume(count);
+        return static_cast<std::streamsize>(count);
+    }
+
+    bool skip(uint64_t count) {
+        while (count > 0) {
+            if (0 == avail() && !fill()) {
+                return false;
+            }
+            size_t chunk = static_cast<size_t>(std::min(count, static_cast<uint64_t>(avail())));
+            consume(chunk);
+            count -= chunk;
+        }
+        return true;
+    }
+};
+
+// compressed data of the entry with the length known from the local header
+class bounded_input_source : public codec_source {
+    stream_input& in;
+    uint64_t& comp_read;
+    uint64_t limit;
+
+public:
+    bounded_input_source(stream_input& in, uint64_t& comp_read, uint64_t limit) :
+    in(in),
+    comp_read(comp_read),
+    limit(limit) { }
+
+    std::streamsize read(sl::io::span<char> span) override {
+        if (comp_read >= limit) {
+            return std::char_traits<char>::eof();
+        }
+        size_t len = static_cast<size_t>(std::min(static_cast<uint64_t>(span.size()), limit - comp_read));
+        std::streamsize res = in.read({span.data(), len});
+        if (res > 0) {
+            comp_read += static_cast<uint64_t>(res);
+        }
+        return res;
+    }
+};
+
+class istream_input_source : public codec_source {
+    std::streambuf* sbuf;
+
+public:
+    explicit istream_input_source(std::streambuf* sbuf) :
+    sbuf(sbuf) { }
+
+    std::streamsize read(sl::io::span<char> span) override {
+        std::streamsize avail = sbuf->in_avail();
+        std::streamsize len = static_cast<std::streamsize>(std::min(span.size(), avail > 0 ?
+                static_cast<size_t>(avail) : istream_read_max));
+        std::streamsize res = sbuf->sgetn(span.data(), len);
+        return res > 0 ? res : std::char_traits<char>::eof();
+    }
+};
+
+// decompressed entry data, lengths and CRC-32 are checked when the end of data is reached
+class stream_entry_source {
+    stream_input& in;
+    stream_entry& entry;
+    bool zip64;
+    bool verify_crc;
+    bool deflate;
+    bool delimited = false;
+    z_stream strm;
+    bool strm_active = false;
+    std::unique_ptr<codec_source> decoder;
+    uint64_t comp_read = 0;
+    uint64_t uncomp_read = 0;
+    uint32_t crc = 0;
+    bool data_finished = false;
+    bool finished = false;
+    std::string error;
+
+public:
+    stream_entry_source(stream_input& in, stream_entry& entry, bool zip64, bool verify_crc) :
+    in(in),
+    entry(entry),
+    zip64(zip64),
+    verify_crc(verify_crc),
+    deflate(static_cast<uint16_t>(sl::compress::zip_compression_method::deflate) == entry.comp_method) {
+        bool store = static_cast<uint16_t>(sl::compress::zip_compression_method::store) == entry.comp_method;
+        if (store) {
+            if (entry.comp_length != entry.uncomp_length) throw unzip_exception(TRACEMSG(
+                    "Invalid stored entry: [" + entry.name + "],"
+                    " compressed length: [" + sl::support::to_string(entry.comp_length) + "],"
+                    " uncompressed length: [" + sl::support::to_string(entry.uncomp_length) + "]," +
+                    " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+            delimited = entry.has_data_descriptor() && 0 == entry.comp_length;
+        } else if (deflate) {
+            std::memset(std::addressof(strm), '\0', sizeof(strm));
+            if (Z_OK != ::inflateInit2(std::addressof(strm), -MAX_WBITS)) throw unzip_exception(TRACEMSG(
+                    "Inflate initialization error, entry: [" + entry.name + "]"));
+            strm_active = true;
+        } else {
+            auto codec = find_codec(entry.comp_method);
+            if (nullptr == codec.get()) throw unzip_exception(TRACEMSG(
+                    "Unsupported compression method: [" + sl::support::to_string(entry.comp_method) + "],"
+                    " in entry: [" + entry.name + "],"
+                    " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+            if (entry.has_data_descriptor() && 0 == entry.comp_length) throw unzip_exception(TRACEMSG(
+                    "Compressed length is deferred to the data descriptor, it is only supported"
+                    " for stored and deflated entries, method: [" + sl::support::to_string(entry.comp_method) + "],"
+                    " entry: [" + entry.name + "],"
+                    " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+            auto compressed = std::unique_ptr<codec_source>(new bounded_input_source(in, comp_read,
+                    entry.comp_length));
+            decoder = codec->open_decoder(std::move(compressed), entry.uncomp_length);
+        }
+    }
+
+    stream_entry_source(const stream_entry_source&) = delete;
+
+    stream_entry_source& operator=(const stream_entry_source&) = delete;
+
+    ~stream_entry_source() STATICLIB_NOEXCEPT {
+        if (strm_active) {
+            ::inflateEnd(std::addressof(strm));
+        }
+    }
+
+    std::streamsize read(sl::io::span<char> span) {
+        // error is reported again after the callback, when it is swallowed by the entry stream
+        if (!error.empty()) throw unzip_exception(TRACEMSG(error));
+        if (finished) {
+            return std::char_traits<char>::eof();
+        }
+        if (0 == span.size()) {
+            return 0;
+        }
+        try {
+            size_t res = data_finished ? 0 : read_data(span);
+            if (res > 0) {
+                crc = crc32_update(crc, span.data(), res);
+                uncomp_read += res;
+                return static_cast<std::streamsize>(res);
+            }
+            finish();
+            return std::char_traits<char>::eof();
+        } catch (const std::exception& e) {
+            error = e.what();
+            throw;
+        }
+    }
+
+    void drain() {
+        std::array<char, 4096> buf;
+        while (std::char_traits<char>::eof() != read({buf.data(), buf.size()})) { }
+    }
+
+private:
+    size_t read_data(sl::io::span<char> span) {
+        if (deflate) {
+            return inflate_data(span);
+        }
+        if (nullptr != decoder.get()) {
+            std::streamsize res = decoder->read(span);
+            if (res <= 0) {
+                data_finished = true;
+                return 0;
+            }
+            return static_cast<size_t>(res);
+        }
+        if (delimited) {
+            return read_delimited(span);
+        }
+        if (comp_read >= entry.comp_length) {
+            data_finished = true;
+            return 0;
+        }
+        size_t len = static_cast<size_t>(std::min(static_cast<uint64_t>(span.size()), entry.comp_length - comp_read));
+        std::streamsize res = in.read({span.data(), len});
+        if (res <= 0) {
+            throw_truncated();
+        }
+        comp_read += static_cast<uint64_t>(res);
+        return static_cast<size_t>(res);
+    }
+
+    // stored data ends where the data descriptor matching the preceding data is found
+    size_t read_delimited(sl::io::span<char> span) {
+        // descriptor is followed by the next header signature
+        size_t desc_len = zip64 ? 28 : 20;
+        if (!in.ensure(desc_len)) {
+            throw_truncated();
+        }
+        const char* data = in.data();
+        size_t scan_len = in.avail() - desc_len + 1;
+        size_t len = std::min(span.size(), scan_len);
+        for (size_t i = 0; i < scan_len; i++) {
+            const char* found = static_cast<const char*>(std::memchr(data + i, 'P', scan_len - i));
+            if (nullptr == found) {
+                break;
+            }
+            i = static_cast<size_t>(found - data);
+            if (is_descriptor_at(data, i)) {
+                len = std::min(span.size(), i);
+                break;
+            }
+        }
+        if (0 == len) {
+            data_finished = true;
+            return 0;
+        }
+        std::memcpy(span.data(), data, len);
+        in.consume(len);
+        comp_read += len;
+        return len;
+    }
+
+    bool is_descriptor_at(const char* data, size_t pos) {
+        const char* ptr = data + pos;
+        if (data_descriptor_signature != load_32_le(ptr)) {
+            return false;
+        }
+        uint64_t length = comp_read + pos;
+        uint64_t comp_length = zip64 ? load_64_le(ptr + 8) : load_32_le(ptr + 8);
+        uint64_t uncomp_length = zip64 ? load_64_le(ptr + 16) : load_32_le(ptr + 12);
+        if (length != comp_length || length != uncomp_length) {
+            return false;
+        }
+        // CRC-32 is not checked when the descriptor is followed by a header,
+        // so the mismatch is reported instead of reading past the entry
+        uint32_t next_sig = load_32_le(ptr + (zip64 ? 24 : 16));
+        return local_header_signature == next_sig || cd_header_signature == next_sig ||
+                eocd_signature == next_sig || zip64_eocd_signature == next_sig ||
+                load_32_le(ptr + 4) == crc32_update(crc, data, pos);
+    }
+
+    size_t inflate_data(sl::io::span<char> span) {
+        size_t len = std::min(span.size(), inflate_chunk_max);
+        strm.next_out = reinterpret_cast<Bytef*>(span.data());
+        strm.avail_out = static_cast<uInt>(len);
+        // end of the deflate stream is found by inflating it,
+        // when the lengths are deferred to the data descriptor
+        while (len == strm.avail_out && !data_finished) {
+            size_t in_len = std::min(in.avail(), inflate_chunk_max);
+            uint64_t limit = entry.has_data_descriptor() ? std::numeric_limits<uint64_t>::max() :
+                    entry.comp_length - comp_read;
+            in_len = static_cast<size_t>(std::min(static_cast<uint64_t>(in_len), limit));
+            strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+            strm.avail_in = static_cast<uInt>(in_len);
+            int err = ::inflate(std::addressof(strm), Z_NO_FLUSH);
+            size_t consumed = in_len - strm.avail_in;
+            in.consume(consumed);
+            comp_read += consumed;
+            strm.next_in = nullptr;
+            strm.avail_in = 0;
+            if (Z_STREAM_END == err) {
+                data_finished = true;
+            } else if (Z_BUF_ERROR == err) {
+                // no progress without more input
+                if (0 == limit) throw unzip_exception(TRACEMSG(
+                        "Unexpected end of compressed data, declared length: [" +
+                        sl::support::to_string(entry.comp_length) + "]," +
+                        " entry: [" + entry.name + "]," +
+                        " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+                if (!in.fill()) {
+                    throw_truncated();
+                }
+            } else if (Z_OK != err) {
+                throw unzip_exception(TRACEMSG(
+                        "Inflate error: [" + sl::support::to_string(err) + "]," +
+                        " message: [" + (nullptr != strm.msg ? std::string(strm.msg) : std::string()) + "]," +
+                        " entry: [" + entry.name + "],"
+                        " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+            }
+        }
+        return len - strm.avail_out;
+    }
+
+    void finish() {
+        finished = true;
+        if (entry.has_data_descriptor()) {
+            read_data_descriptor();
+        } else if (comp_read < entry.comp_length && !in.skip(entry.comp_length - comp_read)) {
+            throw_truncated();
+        } else {
+            comp_read = std::max(comp_read, entry.comp_length);
+        }
+        if (comp_read != entry.comp_length || uncomp_read != entry.uncomp_length) throw unzip_exception(TRACEMSG(
+                "Invalid entry lengths, entry: [" + entry.name + "]," +
+                " declared compressed: [" + sl::support::to_string(entry.comp_length) + "]," +
+                " uncompressed: [" + sl::support::to_string(entry.uncomp_length) + "]," +
+                " actual compressed: [" + sl::support::to_string(comp_read) + "]," +
+                " uncompressed: [" + sl::support::to_string(uncomp_read) + "]," +
+                " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+        if (verify_crc && entry.crc != crc) throw unzip_exception(TRACEMSG(
+                "CRC-32 mismatch in zip entry: [" + entry.name + "]," +
+                " expected: [" + sl::support::to_string(entry.crc) + "]," +
+                " actual: [" + sl::support::to_string(crc) + "]"));
+    }
+
+    void read_data_descriptor() {
+        // signature is optional
+        if (!in.ensure(4)) {
+            throw_truncated();
+        }
+        if (data_descriptor_signature == load_32_le(in.data())) {
+            in.consume(4);
+        }
+        size_t len = zip64 ? 20 : 12;
+        if (!in.ensure(len)) {
+            throw_truncated();
+        }
+        const char* ptr = in.data();
+        entry.crc = load_32_le(ptr);
+        entry.comp_length = zip64 ? load_64_le(ptr + 4) : load_32_le(ptr + 4);
+        entry.uncomp_length = zip64 ? load_64_le(ptr + 12) : load_32_le(ptr + 8);
+        in.consume(len);
+    }
+
+    void throw_truncated() {
+        throw unzip_exception(TRACEMSG(
+                "Unexpected end of ZIP stream, entry: [" + entry.name + "]," +
+                " position: [" + sl::support::to_string(in.get_position()) + "]"));
+    }
+};
+
+stream_entry read_local_header(stream_input& in, bool& zip64) {
+    stream_entry entry;
+    entry.offset = in.get_position();
+    if (!in.ensure(local_header_len)) throw unzip_exception(TRACEMSG(
+            "Unexpected end of ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+    const char* ptr = in.data();
+    entry.flags = load_16_le(ptr + 6);
+    entry.comp_method = load_16_le(ptr + 8);
+    entry.crc = load_32_le(ptr + 14);
+    entry.comp_length = load_32_le(ptr + 18);
+    entry.uncomp_length = load_32_le(ptr + 22);
+    size_t namelen = load_16_le(ptr + 26);
+    size_t extralen = load_16_le(ptr + 28);
+    if (!in.ensure(local_header_len + namelen + extralen)) throw unzip_exception(TRACEMSG(
+            "Unexpected end of ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+    ptr = in.data();
+    entry.name = std::string(ptr + local_header_len, namelen);
+    uint64_t offset = 0;
+    zip64 = read_zip64_extra(ptr + local_header_len + namelen, extralen, true,
+            entry.uncomp_length, entry.comp_length, offset);
+    in.consume(local_header_len + namelen + extralen);
+    if (0 != (entry.flags & encrypted_flag)) throw unzip_exception(TRACEMSG(
+            "Encrypted entries are not supported, entry: [" + entry.name + "]," +
+            " in ZIP stream, position: [" + sl::support::to_string(entry.offset) + "]"));
+    return entry;
+}
+
+} // namespace
+
+size_t read_zip_stream(codec_source& input, std::function<void(const stream_entry&, std::istream&)> callback,
+        stream_options options) {
+    stream_input in{input, options.buffer_size};
+    size_t count = 0;
+    for (;;) {
+        uint64_t position = in.get_position();
+        if (!in.ensure(4)) throw unzip_exception(TRACEMSG(
+                "Unexpected end of ZIP stream, central directory not found," +
+                " position: [" + sl::support::to_string(position) + "]"));
+        uint32_t sig = load_32_le(in.data());
+        if (cd_header_signature == sig || eocd_signature == sig || zip64_eocd_signature == sig) {
+            break;
+        }
+        if (data_descriptor_signature == sig && 0 == position) {
+            // marker of the single-segment spanned archive
+            in.consume(4);
+            continue;
+        }
+        if (local_header_signature != sig) throw unzip_exception(TRACEMSG(
+                "Cannot find local file header in ZIP stream," +
+                " position: [" + sl::support::to_string(position) + "]," +
+                " invalid signature: [" + sl::support::to_string(sig) + "]," +
+                " must be: [" + sl::support::to_string(local_header_signature) + "]"));
+        bool zip64 = false;
+        auto entry = read_local_header(in, zip64);
+        stream_entry_source src{in, entry, zip64, options.verify_crc};
+        {
+            auto stream = sl::io::make_source_istream_ptr(sl::io::make_reference_source(src));
+            callback(entry, *stream);
+        }
+        // data not read by the callback is skipped, data descriptor is checked
+        src.drain();
+        count += 1;
+    }
+    return count;
+}
+
+size_t read_zip_stream(std::istream& input, std::function<void(const stream_entry&, std::istream&)> callback,
+        stream_options options) {
+    istream_input_source src{input.rdbuf()};
+    return read_zip_stream(src, std::move(callback), options);
+}
+
+} // namespace
+}
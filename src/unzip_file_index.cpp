@@ -23,7 +23,14 @@
 
 #include "staticlib/unzip/file_index.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <cstdlib>
 #include <cstring>
@@ -37,11 +44,17 @@
 #include "staticlib/endian.hpp"
 #include "staticlib/io.hpp"
 #include "staticlib/utils.hpp"
-#include "staticlib/tinydir.hpp"
 #include "staticlib/pimpl/forward_macros.hpp"
 
 #include "staticlib/unzip/unzip_exception.hpp"
 
+#include "cd_parser.hpp"
+#include "counting_source.hpp"
+#include "entry_table.hpp"
+#include "index_cache.hpp"
+#include "name_index.hpp"
+#include "zip_format.hpp"
+
 
 namespace staticlib {
 namespace unzip {
@@ -49,68 +62,159 @@ namespace unzip {
 namespace { // anonymous
 
 const uint32_t zip_cd_start_signature = 0x02014b50;
+const uint32_t zip64_eocd_locator_signature = 0x07064b50;
+const uint32_t zip64_eocd_signature = 0x06064b50;
+const uint16_t zip64_marker_16 = 0xffff;
+const size_t zip64_eocd_locator_len = 20;
+const size_t zip64_eocd_len = 56;
+const size_t cd_search_buf_len = 4096;
+const size_t eocd_len = 22;
+// maximum comment length and the EOCD record itself
+const size_t eocd_search_max_len = 0xffff + eocd_len;
+// smaller directories are parsed sequentially even if threads are enabled
+const uint64_t parallel_cd_min_records = 4096;
+const uint64_t swar_ones = 0x0101010101010101ULL;
+const uint64_t swar_highs = 0x8080808080808080ULL;
 
 struct central_directory {
-    uint32_t offset;
-    uint16_t records_count;
+    uint64_t offset;
+    uint64_t records_count;
     
-    central_directory(uint32_t offset, uint16_t records_count) :
+    central_directory(uint64_t offset, uint64_t records_count) :
     offset(offset), 
     records_count(records_count) { }
 };
 
-struct named_file_entry {
-    std::string name;
-    uint16_t cd_en_size;
-    file_entry entry;
+bool has_byte(uint64_t word, unsigned char byte) {
+    uint64_t val = word ^ (swar_ones * byte);
+    return 0 != ((val - swar_ones) & ~val & swar_highs);
+}
 
-    named_file_entry(std::string name, uint16_t cd_en_size, int32_t offset, int32_t comp_length, 
-            int32_t uncomp_length, uint16_t comp_method) :
-    name(std::move(name)),
-    cd_en_size(cd_en_size),
-    entry(offset, comp_length, uncomp_length, comp_method) { }
-        
-    bool is_file() {
-        return '/' != name.back();
+bool is_eocd(const char* buf, size_t len, size_t pos) {
+    if (!(0x50 == buf[pos] && 0x4b == buf[pos + 1] && 0x05 == buf[pos + 2] && 0x06 == buf[pos + 3])) {
+        return false;
     }
+    // comment must fit into the rest of the file
+    size_t comment_len = static_cast<unsigned char>(buf[pos + 20]) |
+            (static_cast<size_t>(static_cast<unsigned char>(buf[pos + 21])) << 8);
+    return pos + eocd_len + comment_len <= len;
+}
 
-};
-
+/**
+ * Searches backward for the last EOCD record, eight candidate positions are
+ * checked at once for the last signature byte, stops on the first valid match
+ */
+std::streamsize find_eocd(const char* buf, size_t len) {
+    if (len < eocd_len) {
+        return -1;
+    }
+    size_t pos = len - eocd_len;
+    for (;;) {
+        size_t low = pos >= 7 ? pos - 7 : 0;
+        if (pos >= 7) {
+            uint64_t word;
+            std::memcpy(std::addressof(word), buf + low + 3, sizeof(word));
+            if (!has_byte(word, 0x06)) {
+                if (0 == low) {
+                    return -1;
+                }
+                pos = low - 1;
+                continue;
+            }
+        }
+        for (size_t i = pos + 1; i-- > low;) {
+            if (is_eocd(buf, len, i)) {
+                return static_cast<std::streamsize>(i);
+            }
+        }
+        if (0 == low) {
+            return -1;
+        }
+        pos = low - 1;
+    }
 }
 
+} // namespace
+
 class file_index::impl : public sl::pimpl::object::impl {
     std::string zip_file_path;
-    std::unordered_map<std::string, file_entry> en_map{};
-    std::vector<std::string> en_list{};
+    // appended to by lazy parsing under the "lazy_mtx" until "cd_complete" is set
+    mutable entry_table table;
+    mutable std::mutex lazy_mtx;
+    mutable std::atomic<bool> cd_complete{true};
+    mutable uint64_t lazy_pos = 0;
+    mutable uint64_t lazy_remaining = 0;
+    mutable std::once_flag en_list_flag;
+    mutable std::vector<std::string> en_list{};
+    mutable std::once_flag sorted_flag;
+    mutable name_index sorted;
+    std::shared_ptr<archive_reader> reader;
+    bool memory_mapped;
+    bool file_backed;
+    bool verify_crc;
+    std::shared_ptr<entry_cache> cache;
+    std::shared_ptr<index_stats> stats;
     
 public:
     ~impl() STATICLIB_NOEXCEPT { };
     
     impl(std::string zip_file_path) :
-    zip_file_path(std::move(zip_file_path)) {
-        auto src = io::make_buffered_source(sl::tinydir::file_source(this->zip_file_path));
-        size_t cd_buf_len = std::min(static_cast<size_t>(src.get_source().size()), src.get_buffer().size());
-        central_directory cd = find_cd(src.get_source(), src.get_buffer().data(), cd_buf_len);
-        src.get_source().seek(cd.offset);
-        std::memset(src.get_buffer().data(), 0, src.get_buffer().size());
-        for (int i = 0; i < cd.records_count; i++) {
-            auto en = read_next_entry(src);
-            en_list.push_back(en.name);
-            if (en.is_file()) {
-                auto res = en_map.emplace(std::move(en.name), en.entry); // value
-                if (!res.second) throw unzip_exception(TRACEMSG(
-                        "Invalid Duplicate entry: [" + (res.first)->first + "] in a zip file: [" + this->zip_file_path + "]"));
-            }
+    impl(std::move(zip_file_path), file_index_options()) { }
+
+    impl(std::string zip_file_path, file_index_options options) :
+    impl(options.memory_mapped ? make_mapped_reader(zip_file_path) : make_file_reader(zip_file_path),
+            options.memory_mapped, true, options) { }
+
+    impl(std::shared_ptr<archive_reader> reader) :
+    impl(std::move(reader), file_index_options()) { }
+
+    impl(std::shared_ptr<archive_reader> reader, file_index_options options) :
+    impl(checked_reader(std::move(reader)), false, false, options) { }
+
+    impl(std::shared_ptr<archive_reader> reader, bool memory_mapped, bool file_backed,
+            const file_index_options& options) :
+    zip_file_path(reader->path()),
+    reader(std::move(reader)),
+    // contents of the memory readers are accessed directly as the mapped file
+    memory_mapped(file_backed ? memory_mapped : nullptr != this->reader->data().data()),
+    file_backed(file_backed),
+    verify_crc(options.verify_crc),
+    cache(options.entry_cache_budget > 0 ? std::make_shared<entry_cache>(options.entry_cache_budget,
+            options.entry_cache_max_entry_size) : std::shared_ptr<entry_cache>()),
+    stats(options.collect_stats ? std::make_shared<index_stats>() : std::shared_ptr<index_stats>()) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t cd_bytes = build(options);
+        if (nullptr != stats.get()) {
+            stats->record_build(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count()), cd_bytes);
         }
     }
 
     file_entry find_zip_entry(const file_index&, const std::string& name) const {
-        auto res = en_map.find(name);
-        if(res != en_map.end()) {
-            return res->second;
-        } else {
-            return file_entry{};
-        }
+        file_entry res;
+        find_id(name.data(), name.length(), res);
+        return res;
+    }
+
+    file_entry find_zip_entry(const file_index&, const char* name, size_t name_len) const {
+        file_entry res;
+        find_id(name, name_len, res);
+        return res;
+    }
+
+    uint32_t find_entry_id(const file_index&, const std::string& name) const {
+        file_entry entry;
+        return find_id(name.data(), name.length(), entry);
+    }
+
+    uint32_t find_entry_id(const file_index&, const char* name, size_t name_len) const {
+        file_entry entry;
+        return find_id(name, name_len, entry);
+    }
+
+    file_entry get_zip_entry(const file_index&, uint32_t id) const {
+        check_id(id);
+        return table.entry(id);
     }
     
     const std::string& get_zip_file_path(const file_index&) const {
@@ -118,35 +222,336 @@ public:
     }
 
     const std::vector<std::string>& get_entries(const file_index&) const {
+        // names list is only materialized when requested
+        std::call_once(en_list_flag, [this] {
+            complete_lazy();
+            en_list.reserve(table.size());
+            for (uint32_t id = 0; id < table.size(); id++) {
+                en_list.emplace_back(table.name_data(id), table.name_len(id));
+            }
+        });
         return en_list;
     }
 
+    size_t get_entries_count(const file_index&) const {
+        complete_lazy();
+        return table.size();
+    }
+
+    sl::io::span<const char> get_entry_name(const file_index&, uint32_t id) const {
+        check_id(id);
+        return sl::io::span<const char>(table.name_data(id), table.name_len(id));
+    }
+
+    sl::io::span<const uint32_t> list_prefix(const file_index&, const std::string& prefix) const {
+        return sorted_names().prefix(table, prefix.data(), prefix.length());
+    }
+
+    std::vector<sl::io::span<const char>> list_directory(const file_index&, const std::string& dir) const {
+        std::string prefix = dir;
+        if (!prefix.empty() && '/' != prefix.back()) {
+            prefix.push_back('/');
+        }
+        std::vector<sl::io::span<const char>> res;
+        sorted_names().children(table, prefix.data(), prefix.length(), res);
+        return res;
+    }
+
+    std::vector<uint32_t> list_glob(const file_index&, const std::string& pattern) const {
+        std::vector<uint32_t> res;
+        sorted_names().glob(table, pattern.data(), pattern.length(), res);
+        return res;
+    }
+
+    bool is_memory_mapped(const file_index&) const {
+        return memory_mapped;
+    }
+
+    bool is_crc_verified(const file_index&) const {
+        return verify_crc;
+    }
+
+    std::shared_ptr<archive_reader> get_archive_reader(const file_index&) const {
+        return reader;
+    }
+
+    std::shared_ptr<entry_cache> get_entry_cache(const file_index&) const {
+        return cache;
+    }
+
+    file_index_stats get_stats(const file_index&) const {
+        return nullptr != stats.get() ? stats->snapshot() : file_index_stats();
+    }
+
+    std::shared_ptr<index_stats> get_stats_collector(const file_index&) const {
+        return stats;
+    }
+
 private:
-    central_directory find_cd(sl::tinydir::file_source& fd, char* buf, std::streamsize buf_size) {
-        fd.seek(-buf_size, 'e');
-        io::read_exact(fd, {buf, buf_size});
-        std::streamsize eocd = -1;
-        for (std::streamsize i = buf_size - 1; i >= 3; i--) {
-            if (0x06 == buf[i] && 0x05 == buf[i - 1] && 0x4b == buf[i - 2] && 0x50 == buf[i - 3]) {
-                eocd = i - 3;
+    uint32_t find_id(const char* name, size_t name_len, file_entry& entry) const {
+        if (!cd_complete.load(std::memory_order_acquire)) {
+            return find_lazy(name, name_len, entry);
+        }
+        uint32_t id = table.find(name, name_len);
+        entry = entry_or_empty(id);
+        return id;
+    }
+
+    file_entry entry_or_empty(uint32_t id) const {
+        if (entry_table::not_found != id) {
+            return table.entry(id);
+        } else {
+            return file_entry{};
+        }
+    }
+
+    void check_id(uint32_t id) const {
+        // table is not changed after the lazy parsing is completed
+        complete_lazy();
+        if (id >= table.size()) throw unzip_exception(TRACEMSG(
+                "Invalid entry id: [" + sl::support::to_string(id) + "]," +
+                " entries count: [" + sl::support::to_string(table.size()) + "]," +
+                " in zip file: [" + zip_file_path + "]"));
+    }
+
+    void complete_lazy() const {
+        if (!cd_complete.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> guard{lazy_mtx};
+            parse_lazy(nullptr, 0);
+        }
+    }
+
+    const name_index& sorted_names() const {
+        std::call_once(sorted_flag, [this] {
+            complete_lazy();
+            sorted.build(table);
+        });
+        return sorted;
+    }
+
+    static std::shared_ptr<archive_reader> checked_reader(std::shared_ptr<archive_reader>&& reader) {
+        if (nullptr == reader.get()) throw unzip_exception(TRACEMSG(
+                "Invalid null archive reader specified"));
+        return std::move(reader);
+    }
+
+private:
+    uint64_t build(const file_index_options& options) {
+        std::array<char, cd_search_buf_len> buf;
+        size_t cd_buf_len = static_cast<size_t>(std::min(reader->size(), static_cast<uint64_t>(buf.size())));
+        auto tail = archive_range_source(reader, reader->size() - cd_buf_len, cd_buf_len);
+        io::read_exact(tail, {buf.data(), cd_buf_len});
+        central_directory cd = find_cd(buf.data(), cd_buf_len);
+        if (cd.offset > reader->size()) throw unzip_exception(TRACEMSG(
+                "Invalid Central Directory offset: [" + sl::support::to_string(cd.offset) + "]," +
+                " in an alleged zip file: [" + this->zip_file_path + "]"));
+        index_cache_key key;
+        if (!options.index_cache_path.empty()) {
+            key.archive_size = reader->size();
+            // other readers are identified by size and the tail checksum
+            key.archive_mtime = file_backed ? file_modified_time(this->zip_file_path) : 0;
+            key.cd_offset = cd.offset;
+            key.records_count = cd.records_count;
+            key.tail_crc = static_cast<uint32_t>(::crc32(0, reinterpret_cast<const Bytef*>(buf.data()),
+                    static_cast<uInt>(cd_buf_len)));
+            if (load_index_cache(options.index_cache_path, key, table)) {
+                return 0;
             }
+        } else if (options.lazy && cd.records_count > 0) {
+            lazy_pos = cd.offset;
+            lazy_remaining = cd.records_count;
+            cd_complete.store(false, std::memory_order_release);
+            return 0;
+        }
+        uint64_t cd_bytes = read_cd(cd, options.cd_threads_count);
+        if (!options.index_cache_path.empty()) {
+            try {
+                save_index_cache(options.index_cache_path, key, table);
+            } catch (const std::exception&) {
+                // cache is optional, index is fully usable without it
+            }
+        }
+        return cd_bytes;
+    }
+
+    uint64_t read_cd(const central_directory& cd, size_t threads_count) {
+        auto data = reader->data();
+        if (0 == threads_count) {
+            threads_count = static_cast<size_t>(std::thread::hardware_concurrency());
+        }
+        if (threads_count > 1 && cd.records_count >= parallel_cd_min_records) {
+            size_t cd_len = static_cast<size_t>(reader->size() - cd.offset);
+            if (memory_mapped) {
+                return parse_cd_parallel({data.data() + cd.offset, cd_len}, cd.records_count, threads_count,
+                        zip_file_path, table);
+            }
+            // whole directory is fetched with a single read
+            std::vector<char> buf;
+            buf.resize(cd_len);
+            auto src = archive_range_source(reader, cd.offset, cd_len);
+            io::read_exact(src, {buf.data(), buf.size()});
+            return parse_cd_parallel({buf.data(), buf.size()}, cd.records_count, threads_count,
+                    zip_file_path, table);
+        }
+        if (memory_mapped) {
+            auto src = io::array_source(data.data() + cd.offset, data.size() - cd.offset);
+            auto counted = counting_source<io::array_source>(src);
+            read_cd(counted, cd);
+            return counted.get_count();
+        }
+        auto src = io::make_buffered_source(archive_range_source(reader, cd.offset, reader->size() - cd.offset));
+        auto counted = counting_source<decltype(src)>(src);
+        read_cd(counted, cd);
+        return counted.get_count();
+    }
+
+    template<typename Source>
+    void read_cd(Source& src, const central_directory& cd) {
+        // count is read from the end record, it is clamped by the number of records that can fit,
+        // names length is unknown before parsing, 32 bytes average is assumed
+        uint64_t count = std::min(cd.records_count, (reader->size() - cd.offset) / cd_header_len);
+        table.reserve(static_cast<size_t>(count), static_cast<size_t>(count) * 32);
+        std::string name{};
+        std::vector<char> extra{};
+        for (uint64_t i = 0; i < cd.records_count; i++) {
+            auto entry = read_next_entry(src, name, extra);
+            add_record(name, entry);
+        }
+    }
+
+    uint32_t add_record(const std::string& name, const file_entry& entry) const {
+        size_t count_before = table.size();
+        uint32_t id = table.add(name.data(), name.length(), entry);
+        if (count_before == table.size()) throw unzip_exception(TRACEMSG(
+                "Invalid Duplicate entry: [" + name + "] in a zip file: [" + this->zip_file_path + "]"));
+        return id;
+    }
+
+    uint32_t find_lazy(const char* name, size_t name_len, file_entry& entry) const {
+        std::lock_guard<std::mutex> guard{lazy_mtx};
+        uint32_t id = table.find(name, name_len);
+        if (entry_table::not_found == id) {
+            id = parse_lazy(name, name_len);
+        }
+        entry = entry_or_empty(id);
+        return id;
+    }
+
+    // parses remaining records until the specified file entry is found,
+    // all of them if name is not specified, must be called under the "lazy_mtx"
+    uint32_t parse_lazy(const char* name, size_t name_len) const {
+        if (0 == lazy_remaining) {
+            return entry_table::not_found;
+        }
+        uint32_t res = entry_table::not_found;
+        uint64_t parsed = 0;
+        if (memory_mapped) {
+            auto data = reader->data();
+            auto src = io::array_source(data.data() + lazy_pos, data.size() - lazy_pos);
+            auto counted = counting_source<io::array_source>(src);
+            res = parse_records(counted, name, name_len);
+            parsed = counted.get_count();
+        } else {
+            auto src = io::make_buffered_source(archive_range_source(reader, lazy_pos, reader->size() - lazy_pos));
+            auto counted = counting_source<decltype(src)>(src);
+            res = parse_records(counted, name, name_len);
+            parsed = counted.get_count();
+        }
+        if (nullptr != stats.get()) {
+            stats->record_cd_bytes(parsed);
+        }
+        if (0 == lazy_remaining) {
+            cd_complete.store(true, std::memory_order_release);
+        }
+        return res;
+    }
+
+    template<typename Source>
+    uint32_t parse_records(counting_source<Source>& src, const char* name, size_t name_len) const {
+        std::string en_name{};
+        std::vector<char> extra{};
+        uint64_t start_pos = lazy_pos;
+        while (lazy_remaining > 0) {
+            auto entry = read_next_entry(src, en_name, extra);
+            uint32_t id = add_record(en_name, entry);
+            lazy_remaining -= 1;
+            // position is advanced only by complete records
+            lazy_pos = start_pos + src.get_count();
+            bool is_file = !en_name.empty() && '/' != en_name.back();
+            if (nullptr != name && is_file && name_len == en_name.length() &&
+                    0 == std::memcmp(name, en_name.data(), name_len)) {
+                return id;
+            }
+        }
+        return entry_table::not_found;
+    }
+
+    central_directory find_cd(const char* tail, size_t tail_len) const {
+        const char* buf = tail;
+        size_t buf_size = tail_len;
+        std::vector<char> extended;
+        std::streamsize eocd = find_eocd(buf, buf_size);
+        if (-1 == eocd && tail_len < reader->size()) {
+            // EOCD is followed by a long comment
+            buf_size = static_cast<size_t>(std::min(reader->size(), static_cast<uint64_t>(eocd_search_max_len)));
+            extended.resize(buf_size);
+            auto src = archive_range_source(reader, reader->size() - buf_size, buf_size);
+            io::read_exact(src, {extended.data(), buf_size});
+            buf = extended.data();
+            eocd = find_eocd(buf, buf_size);
         }
         if (-1 == eocd) throw unzip_exception(TRACEMSG("Cannot find Central Directory" + 
                 " in an alleged zip file: [" + zip_file_path + "],"
                 " searching through: [" + sl::support::to_string(buf_size) + "] bytes on the end of the file"));
-        if (eocd > buf_size - 22) throw unzip_exception(TRACEMSG("Invalid EOCD position " + 
-                " (from end): [" + sl::support::to_string(buf_size - eocd) + "],"
-                " in an alleged zip file: [" + zip_file_path + "]"));
+        uint64_t buf_offset = reader->size() - buf_size;
         uint32_t offset; 
         ::memcpy(std::addressof(offset), buf + eocd + 16, 4);
         offset = le32toh(offset);
         uint16_t records_count;
         ::memcpy(std::addressof(records_count), buf + eocd + 8, 2);
         records_count = le16toh(records_count);
+        uint64_t eocd_pos = buf_offset + static_cast<uint64_t>(eocd);
+        if (eocd_pos >= zip64_eocd_locator_len) {
+            uint64_t locator_pos = eocd_pos - zip64_eocd_locator_len;
+            auto zip64_cd = find_zip64_cd(locator_pos);
+            if (zip64_cd.first) {
+                return zip64_cd.second;
+            }
+        }
+        if (zip64_marker_32 == offset || zip64_marker_16 == records_count) throw unzip_exception(TRACEMSG(
+                "Cannot find Zip64 end of central directory locator" +
+                " in an alleged zip file: [" + zip_file_path + "]"));
         return central_directory(offset, records_count);
     }
 
-    named_file_entry read_next_entry(io::buffered_source<sl::tinydir::file_source>& src) {
+    std::pair<bool, central_directory> find_zip64_cd(uint64_t locator_pos) const {
+        auto locator = archive_range_source(reader, locator_pos, zip64_eocd_locator_len);
+        uint32_t locator_sig = sl::endian::read_32_le<uint32_t>(locator);
+        if (zip64_eocd_locator_signature != locator_sig) {
+            return std::make_pair(false, central_directory(0, 0));
+        }
+        std::array<char, 32> skip;
+        io::skip(locator, skip, 4);
+        uint64_t eocd_pos = sl::endian::read_64_le<uint64_t>(locator);
+        if (eocd_pos + zip64_eocd_len > locator_pos) throw unzip_exception(TRACEMSG(
+                "Invalid Zip64 end of central directory position: [" + sl::support::to_string(eocd_pos) + "]," +
+                " in an alleged zip file: [" + zip_file_path + "]"));
+        auto eocd = archive_range_source(reader, eocd_pos, zip64_eocd_len);
+        uint32_t eocd_sig = sl::endian::read_32_le<uint32_t>(eocd);
+        if (zip64_eocd_signature != eocd_sig) throw unzip_exception(TRACEMSG(
+                "Cannot find Zip64 end of central directory record" +
+                " in an alleged zip file: [" + zip_file_path + "]," +
+                " invalid signature: [" + sl::support::to_string(eocd_sig) + "]," +
+                " must be: [" + sl::support::to_string(zip64_eocd_signature) + "]"));
+        io::skip(eocd, skip, 28);
+        uint64_t records_count = sl::endian::read_64_le<uint64_t>(eocd);
+        io::skip(eocd, skip, 8);
+        uint64_t offset = sl::endian::read_64_le<uint64_t>(eocd);
+        return std::make_pair(true, central_directory(offset, records_count));
+    }
+
+    template<typename Source>
+    file_entry read_next_entry(Source& src, std::string& filename, std::vector<char>& extra) const {
         uint32_t sig = sl::endian::read_32_le<uint32_t>(src);
         if (zip_cd_start_signature != sig) {
             throw unzip_exception(TRACEMSG("Cannot find Central Directory file header" + 
@@ -157,26 +562,56 @@ private:
         std::array<char, 32> skip;
         io::skip(src, skip, 6);
         uint16_t comp_method = sl::endian::read_16_le<uint16_t>(src);
-        io::skip(src, skip, 8);
-        int32_t comp_length = sl::endian::read_32_le<int32_t>(src);
-        int32_t uncomp_length = sl::endian::read_32_le<int32_t>(src);
+        io::skip(src, skip, 4);
+        uint32_t crc = sl::endian::read_32_le<uint32_t>(src);
+        uint64_t comp_length = sl::endian::read_32_le<uint32_t>(src);
+        uint64_t uncomp_length = sl::endian::read_32_le<uint32_t>(src);
         uint16_t namelen = sl::endian::read_16_le<uint16_t>(src);
         uint16_t extralen = sl::endian::read_16_le<uint16_t>(src);
         uint16_t commentlen = sl::endian::read_16_le<uint16_t>(src);
         io::skip(src, skip, 8);
-        uint32_t offset = sl::endian::read_32_le<uint32_t>(src);
-        std::string filename{};
+        uint64_t offset = sl::endian::read_32_le<uint32_t>(src);
         filename.resize(namelen);
         io::read_exact(src, {std::addressof(filename.front()), namelen});
-        // skip extra and comment
-        io::skip(src, skip, extralen + commentlen);
-        return named_file_entry(std::move(filename), 46 + namelen + extralen + commentlen, offset, comp_length, uncomp_length, comp_method);
+        if (zip64_marker_32 == uncomp_length || zip64_marker_32 == comp_length || zip64_marker_32 == offset) {
+            extra.resize(extralen);
+            io::read_exact(src, {extra.data(), extra.size()});
+            read_zip64_extra(extra.data(), extra.size(), false, uncomp_length, comp_length, offset);
+            if (zip64_marker_32 == uncomp_length || zip64_marker_32 == comp_length ||
+                    zip64_marker_32 == offset) throw unzip_exception(TRACEMSG(
+                    "Cannot find Zip64 extended information for entry: [" + filename + "]" +
+                    " in an alleged zip file: [" + zip_file_path + "]"));
+        } else {
+            io::skip(src, skip, extralen);
+        }
+        // skip comment
+        io::skip(src, skip, commentlen);
+        return file_entry(static_cast<int64_t>(offset), static_cast<int64_t>(comp_length),
+                static_cast<int64_t>(uncomp_length), comp_method, crc);
     }
 };
 PIMPL_FORWARD_CONSTRUCTOR(file_index, (std::string), (), unzip_exception)
+PIMPL_FORWARD_CONSTRUCTOR(file_index, (std::string)(file_index_options), (), unzip_exception)
+PIMPL_FORWARD_CONSTRUCTOR(file_index, (std::shared_ptr<archive_reader>), (), unzip_exception)
+PIMPL_FORWARD_CONSTRUCTOR(file_index, (std::shared_ptr<archive_reader>)(file_index_options), (), unzip_exception)
 PIMPL_FORWARD_METHOD(file_index, file_entry, find_zip_entry, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, file_entry, find_zip_entry, (const char*)(size_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, uint32_t, find_entry_id, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, uint32_t, find_entry_id, (const char*)(size_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, file_entry, get_zip_entry, (uint32_t), (const), unzip_exception)
 PIMPL_FORWARD_METHOD(file_index, const std::string&, get_zip_file_path, (), (const), unzip_exception)
 PIMPL_FORWARD_METHOD(file_index, const std::vector<std::string>&, get_entries, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, size_t, get_entries_count, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, sl::io::span<const char>, get_entry_name, (uint32_t), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, sl::io::span<const uint32_t>, list_prefix, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, std::vector<sl::io::span<const char>>, list_directory, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, std::vector<uint32_t>, list_glob, (const std::string&), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, bool, is_memory_mapped, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, bool, is_crc_verified, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, std::shared_ptr<archive_reader>, get_archive_reader, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, std::shared_ptr<entry_cache>, get_entry_cache, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, file_index_stats, get_stats, (), (const), unzip_exception)
+PIMPL_FORWARD_METHOD(file_index, std::shared_ptr<index_stats>, get_stats_collector, (), (const), unzip_exception)
 
 } // namespace
 }
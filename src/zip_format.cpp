@@ -0,0 +1,72 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   zip_format.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:15 AM
+ */
+
+#include "zip_format.hpp"
+
+#include <limits>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+bool read_zip64_extra(const char* extra, size_t extralen, bool local_header,
+        uint64_t& uncomp_length, uint64_t& comp_length, uint64_t& offset) {
+    bool found = false;
+    size_t pos = 0;
+    while (extralen - pos >= 4) {
+        uint16_t header_id = load_16_le(extra + pos);
+        uint16_t data_len = load_16_le(extra + pos + 2);
+        pos += 4;
+        if (data_len > extralen - pos) {
+            break;
+        }
+        if (zip64_extra_header_id == header_id) {
+            found = true;
+            size_t field_pos = pos;
+            uint64_t* fields[] = {std::addressof(uncomp_length), std::addressof(comp_length), std::addressof(offset)};
+            size_t fields_count = local_header ? 2 : 3;
+            for (size_t i = 0; i < fields_count && field_pos + 8 <= pos + data_len; i++) {
+                bool present = local_header || zip64_marker_32 == *fields[i];
+                if (zip64_marker_32 == *fields[i]) {
+                    uint64_t val = load_64_le(extra + field_pos);
+                    // entries store lengths and offsets as signed values
+                    if (val > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) throw unzip_exception(TRACEMSG(
+                            "Invalid Zip64 extended information, value: [" + sl::support::to_string(val) + "]," +
+                            " exceeds the maximum: [" + sl::support::to_string(std::numeric_limits<int64_t>::max()) + "]"));
+                    *fields[i] = val;
+                }
+                if (present) {
+                    field_pos += 8;
+                }
+            }
+        }
+        pos += data_len;
+    }
+    return found;
+}
+
+} // namespace
+}
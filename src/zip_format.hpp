@@ -0,0 +1,115 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   zip_format.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:10 AM
+ */
+
+#ifndef STATICLIB_UNZIP_ZIP_FORMAT_HPP
+#define STATICLIB_UNZIP_ZIP_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "staticlib/endian.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Header ID of the Zip64 extended information extra field
+ */
+const uint16_t zip64_extra_header_id = 0x0001;
+
+/**
+ * Value of the 32-bit field that is stored in the Zip64 extended information instead
+ */
+const uint32_t zip64_marker_32 = 0xffffffff;
+
+/**
+ * Length of the fixed part of the central directory file header
+ */
+const size_t cd_header_len = 46;
+
+/**
+ * Maximum input or output length passed to a single zlib call,
+ * zlib stream counters are 32-bit
+ */
+const size_t inflate_chunk_max = 1 << 30;
+
+/**
+ * Loads 16-bit little-endian value from unaligned memory
+ *
+ * @param ptr pointer to 2 bytes
+ * @return loaded value
+ */
+inline uint16_t load_16_le(const char* ptr) {
+    uint16_t res;
+    std::memcpy(std::addressof(res), ptr, 2);
+    return le16toh(res);
+}
+
+/**
+ * Loads 32-bit little-endian value from unaligned memory
+ *
+ * @param ptr pointer to 4 bytes
+ * @return loaded value
+ */
+inline uint32_t load_32_le(const char* ptr) {
+    uint32_t res;
+    std::memcpy(std::addressof(res), ptr, 4);
+    return le32toh(res);
+}
+
+/**
+ * Loads 64-bit little-endian value from unaligned memory
+ *
+ * @param ptr pointer to 8 bytes
+ * @return loaded value
+ */
+inline uint64_t load_64_le(const char* ptr) {
+    uint64_t res;
+    std::memcpy(std::addressof(res), ptr, 8);
+    return le64toh(res);
+}
+
+/**
+ * Replaces the lengths and offset, that are set to "zip64_marker_32", with the values
+ * from the Zip64 extended information extra field. In central directory records only
+ * the overflowing fields are present, in local file headers both lengths are always present
+ * and the offset is not present.
+ *
+ * @param extra extra field contents
+ * @param extralen extra field length
+ * @param local_header whether extra field belongs to the local file header
+ * @param uncomp_length uncompressed length
+ * @param comp_length compressed length
+ * @param offset local file header offset
+ * @return true if Zip64 extended information is found, false otherwise
+ * @throws unzip_exception if a value does not fit into a signed 64-bit integer
+ */
+bool read_zip64_extra(const char* extra, size_t extralen, bool local_header,
+        uint64_t& uncomp_length, uint64_t& comp_length, uint64_t& offset);
+
+} // namespace
+}
+
+#endif /* STATICLIB_UNZIP_ZIP_FORMAT_HPP */
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   zstd_codec.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 11:55 PM
+ */
+
+#include "zstd_codec.hpp"
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "zstd.h"
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+namespace { // anonymous
+
+struct dstream_deleter {
+    void operator()(ZSTD_DStream* ds) {
+        ZSTD_freeDStream(ds);
+    }
+};
+
+struct dctx_deleter {
+    void operator()(ZSTD_DCtx* dctx) {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+void check_zstd_error(size_t code) {
+    if (ZSTD_isError(code)) throw unzip_exception(TRACEMSG(
+            "Zstandard decompression error: [" + std::string(ZSTD_getErrorName(code)) + "]"));
+}
+
+class zstd_decoder : public codec_source {
+    std::unique_ptr<codec_source> compressed;
+    std::unique_ptr<ZSTD_DStream, dstream_deleter> dstream;
+    std::vector<char> buf;
+    ZSTD_inBuffer in;
+    bool input_finished = false;
+    uint64_t avail;
+
+public:
+    zstd_decoder(std::unique_ptr<codec_source>&& compressed, uint64_t uncomp_length) :
+    compressed(std::move(compressed)),
+    dstream(ZSTD_createDStream()),
+    avail(uncomp_length) {
+        if (nullptr == dstream.get()) throw unzip_exception(TRACEMSG(
+                "Zstandard decompression stream initialization error"));
+        check_zstd_error(ZSTD_initDStream(dstream.get()));
+        buf.resize(ZSTD_DStreamInSize());
+        in.src = buf.data();
+        in.size = 0;
+        in.pos = 0;
+    }
+
+    std::streamsize read(sl::io::span<char> span) override {
+        if (0 == avail) {
+            return std::char_traits<char>::eof();
+        }
+        ZSTD_outBuffer out;
+        out.dst = span.data();
+        out.size = span.size() <= avail ? span.size() : static_cast<size_t>(avail);
+        out.pos = 0;
+        while (0 == out.pos && out.size > 0) {
+            if (in.pos == in.size && !input_finished) {
+                auto read = sl::io::read_all(*compressed, {buf.data(), buf.size()});
+                input_finished = read <= 0;
+                in.size = read > 0 ? static_cast<size_t>(read) : 0;
+                in.pos = 0;
+            }
+            check_zstd_error(ZSTD_decompressStream(dstream.get(), std::addressof(out), std::addressof(in)));
+            if (0 == out.pos && input_finished && in.pos == in.size) throw unzip_exception(TRACEMSG(
+                    "Unexpected end of Zstandard data, remaining length: [" + sl::support::to_string(avail) + "]"));
+        }
+        avail -= static_cast<uint64_t>(out.pos);
+        return static_cast<std::streamsize>(out.pos);
+    }
+};
+
+class zstd_codec : public entry_codec {
+public:
+    std::string name() const override {
+        return "zstd";
+    }
+
+    std::unique_ptr<codec_source> open_decoder(std::unique_ptr<codec_source> compressed,
+            uint64_t uncomp_length) const override {
+        return std::unique_ptr<codec_source>(new zstd_decoder(std::move(compressed), uncomp_length));
+    }
+
+    void decode(sl::io::span<const char> in, sl::io::span<char> out) const override {
+        // context allocation is expensive compared to decoding of small entries
+        static thread_local std::unique_ptr<ZSTD_DCtx, dctx_deleter> dctx;
+        if (nullptr == dctx.get()) {
+            dctx.reset(ZSTD_createDCtx());
+            if (nullptr == dctx.get()) throw unzip_exception(TRACEMSG(
+                    "Zstandard decompression context initialization error"));
+        }
+        size_t len = ZSTD_decompressDCtx(dctx.get(), out.data(), out.size(), in.data(), in.size());
+        check_zstd_error(len);
+        if (out.size() != len) throw unzip_exception(TRACEMSG(
+                "Invalid length of Zstandard data, expected: [" + sl::support::to_string(out.size()) + "]," +
+                " actual: [" + sl::support::to_string(len) + "]"));
+    }
+};
+
+} // namespace
+
+std::shared_ptr<const entry_codec> make_zstd_codec() {
+    return std::make_shared<zstd_codec>();
+}
+
+} // namespace
+}
+
+#endif // STATICLIB_UNZIP_WITH_ZSTD
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   zstd_codec.hpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 11:50 PM
+ */
+
+#ifndef STATICLIB_UNZIP_ZSTD_CODEC_HPP
+#define STATICLIB_UNZIP_ZSTD_CODEC_HPP
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+
+#include <memory>
+
+#include "staticlib/unzip/entry_codec.hpp"
+
+namespace staticlib {
+namespace unzip {
+
+/**
+ * Creates codec for the Zstandard-compressed entries (method 93)
+ *
+ * @return codec instance
+ */
+std::shared_ptr<const entry_codec> make_zstd_codec();
+
+} // namespace
+}
+
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+
+#endif /* STATICLIB_UNZIP_ZSTD_CODEC_HPP */
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   archive_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 11:02 AM
+ */
+
+#include "staticlib/unzip/archive_reader.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "staticlib/unzip/unzip_exception.hpp"
+
+
+namespace uz = staticlib::unzip;
+
+void test_mapped() {
+    auto reader = uz::make_mapped_reader("../test/data/test.zip");
+    auto data = reader->data();
+    slassert(reader->size() == data.size());
+    slassert("PK" == std::string(data.data(), 2));
+    std::array<char, 4> buf;
+    auto read = reader->read_at(reader->size() - 2, {buf.data(), buf.size()});
+    slassert(2 == read);
+    slassert(std::char_traits<char>::eof() == reader->read_at(reader->size(), {buf.data(), buf.size()}));
+}
+
+void test_file() {
+    auto reader = uz::make_file_reader("../test/data/test.zip");
+    slassert(0 == reader->data().size());
+    auto mapped = uz::make_mapped_reader("../test/data/test.zip");
+    slassert(mapped->size() == reader->size());
+    std::array<char, 16> buf;
+    auto read = reader->read_at(10, {buf.data(), buf.size()});
+    slassert(16 == read);
+    slassert(std::string(mapped->data().data() + 10, 16) == std::string(buf.data(), buf.size()));
+    uz::archive_range_source src{reader, reader->size() - 5, 5};
+    slassert(5 == src.read({buf.data(), buf.size()}));
+    slassert(reader->size() == src.get_position());
+    slassert(std::char_traits<char>::eof() == src.read({buf.data(), buf.size()}));
+}
+
+void test_memory() {
+    std::string contents = "PK0123456789";
+    auto reader = uz::make_memory_reader({contents.data(), contents.length()});
+    slassert("memory" == reader->path());
+    slassert(contents.length() == reader->size());
+    slassert(contents.data() == reader->data().data());
+    std::array<char, 4> buf;
+    slassert(4 == reader->read_at(2, {buf.data(), buf.size()}));
+    slassert("0123" == std::string(buf.data(), buf.size()));
+    slassert(2 == reader->read_at(10, {buf.data(), buf.size()}));
+    slassert(std::char_traits<char>::eof() == reader->read_at(12, {buf.data(), buf.size()}));
+}
+
+void test_source() {
+    auto mapped = uz::make_mapped_reader("../test/data/test.zip");
+    auto reader = uz::make_source_reader(sl::tinydir::file_source("../test/data/test.zip"), mapped->size(), "test");
+    slassert("test" == reader->path());
+    slassert(0 == reader->data().size());
+    std::array<char, 16> buf;
+    slassert(16 == reader->read_at(20, {buf.data(), buf.size()}));
+    slassert(std::string(mapped->data().data() + 20, 16) == std::string(buf.data(), buf.size()));
+    slassert(16 == reader->read_at(4, {buf.data(), buf.size()}));
+    slassert(std::string(mapped->data().data() + 4, 16) == std::string(buf.data(), buf.size()));
+    slassert(std::char_traits<char>::eof() == reader->read_at(reader->size(), {buf.data(), buf.size()}));
+}
+
+void test_range() {
+    auto mapped = uz::make_mapped_reader("../test/data/test.zip");
+    auto range = uz::make_range_reader(mapped, 10, 20, "range");
+    slassert(20 == range->size());
+    slassert(mapped->data().data() + 10 == range->data().data());
+    std::array<char, 16> buf;
+    slassert(10 == range->read_at(10, {buf.data(), buf.size()}));
+    slassert(std::string(mapped->data().data() + 20, 10) == std::string(buf.data(), 10));
+    slassert(std::char_traits<char>::eof() == range->read_at(20, {buf.data(), buf.size()}));
+    auto file_range = uz::make_range_reader(uz::make_file_reader("../test/data/test.zip"), 10, 20, "range");
+    slassert(nullptr == file_range->data().data());
+    bool thrown = false;
+    try {
+        uz::make_range_reader(mapped, mapped->size() - 5, 6, "range");
+    } catch (const uz::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_mapped();
+        test_file();
+        test_memory();
+        test_source();
+        test_range();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
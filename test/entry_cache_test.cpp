@@ -0,0 +1,121 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   entry_cache_test.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 9:40 PM
+ */
+
+#include "staticlib/unzip/entry_cache.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+
+namespace uz = staticlib::unzip;
+
+std::shared_ptr<const std::vector<char>> make_data(size_t len, char ch) {
+    return std::make_shared<std::vector<char>>(len, ch);
+}
+
+void test_lru() {
+    // single shard: budget is less than two max entries
+    uz::entry_cache cache{100, 60};
+    slassert(60 == cache.get_entry_max_size());
+    slassert(nullptr == cache.get(1).get());
+    cache.put(1, make_data(40, 'a'));
+    cache.put(2, make_data(40, 'b'));
+    // 1 becomes the most recently used
+    slassert('a' == cache.get(1)->front());
+    cache.put(3, make_data(40, 'c'));
+    slassert(nullptr == cache.get(2).get());
+    slassert('a' == cache.get(1)->front());
+    slassert('c' == cache.get(3)->front());
+    auto stats = cache.get_stats();
+    slassert(3 == stats.hits);
+    slassert(2 == stats.misses);
+    slassert(1 == stats.evictions);
+    slassert(2 == stats.entries_count);
+    slassert(80 == stats.bytes_used);
+    cache.clear();
+    slassert(0 == cache.get_stats().bytes_used);
+    slassert(nullptr == cache.get(1).get());
+}
+
+void test_too_large() {
+    uz::entry_cache cache{100, 10};
+    auto data = make_data(11, 'a');
+    auto res = cache.put(1, data);
+    slassert(data.get() == res.get());
+    slassert(nullptr == cache.get(1).get());
+    slassert(0 == cache.get_stats().entries_count);
+}
+
+void test_put_existing() {
+    uz::entry_cache cache{100, 10};
+    auto first = make_data(5, 'a');
+    cache.put(1, first);
+    auto res = cache.put(1, make_data(5, 'b'));
+    slassert(first.get() == res.get());
+    slassert(5 == cache.get_stats().bytes_used);
+}
+
+void test_concurrent() {
+    uz::entry_cache cache{1 << 20, 1 << 10};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; t++) {
+        threads.emplace_back([&cache, &failures] {
+            for (uint64_t i = 0; i < 10000; i++) {
+                uint64_t key = i % 2000;
+                auto data = cache.get(key);
+                if (nullptr == data.get()) {
+                    data = cache.put(key, make_data(100, static_cast<char>(key % 100)));
+                }
+                if (static_cast<char>(key % 100) != data->front()) {
+                    failures += 1;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(0 == failures.load());
+    auto stats = cache.get_stats();
+    slassert(80000 == stats.hits + stats.misses);
+    slassert(stats.bytes_used <= (1 << 20));
+}
+
+int main() {
+    try {
+        test_lru();
+        test_too_large();
+        test_put_existing();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_codec_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:30 AM
+ */
+
+#include "staticlib/unzip/entry_codec.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+#include "zstd.h"
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/unzip/operations.hpp"
+
+#include "zip_writer.hpp"
+
+namespace uz = staticlib::unzip;
+
+const uint16_t xor_method = 1000;
+const char xor_key = 0x5a;
+
+class xor_decoder : public uz::codec_source {
+    std::unique_ptr<uz::codec_source> compressed;
+
+public:
+    explicit xor_decoder(std::unique_ptr<uz::codec_source>&& compressed) :
+    compressed(std::move(compressed)) { }
+
+    std::streamsize read(sl::io::span<char> span) override {
+        auto res = compressed->read(span);
+        for (std::streamsize i = 0; i < res; i++) {
+            span.data()[i] ^= xor_key;
+        }
+        return res;
+    }
+};
+
+// test codec, "compressed" data is XORed with a constant key
+class xor_codec : public uz::entry_codec {
+public:
+    std::string name() const override {
+        return "xor";
+    }
+
+    std::unique_ptr<uz::codec_source> open_decoder(std::unique_ptr<uz::codec_source> compressed,
+            uint64_t) const override {
+        return std::unique_ptr<uz::codec_source>(new xor_decoder(std::move(compressed)));
+    }
+
+    void decode(sl::io::span<const char> in, sl::io::span<char> out) const override {
+        slassert(in.size() == out.size());
+        for (size_t i = 0; i < in.size(); i++) {
+            out.data()[i] = in.data()[i] ^ xor_key;
+        }
+    }
+};
+
+std::string xor_data(const std::string& data) {
+    std::string res = data;
+    for (auto& ch : res) {
+        ch ^= xor_key;
+    }
+    return res;
+}
+
+// writes single entry compressed with the specified method
+void write_zip(const std::string& path, const std::string& name, const std::string& data, uint16_t method,
+        const std::string& comp) {
+    zip_writer::write_archive(path, {zip_writer::gen_entry(name, data, method, comp)});
+}
+
+std::string gen_data(size_t len) {
+    std::string res;
+    while (res.length() < len) {
+        res += "line " + std::to_string(res.length()) + "\n";
+    }
+    res.resize(len);
+    return res;
+}
+
+std::string read_stream(const uz::file_index& idx, const std::string& name) {
+    auto stream = uz::open_zip_entry(idx, name);
+    return std::string{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+}
+
+void check_entry(const std::string& path, const std::string& name, const std::string& data) {
+    for (bool mapped : {false, true}) {
+        uz::file_index_options opts;
+        opts.memory_mapped = mapped;
+        opts.verify_crc = true;
+        uz::file_index idx{path, opts};
+        slassert(data == read_stream(idx, name));
+        auto read = uz::read_entry(idx, name);
+        slassert(data == std::string(read.data(), read.size()));
+        auto res = uz::verify_archive(idx);
+        slassert(1 == res.entries_count);
+        slassert(res.failed_entries.empty());
+    }
+    // codec streams record the same counters as the inflated ones
+    uz::file_index_options opts;
+    opts.collect_stats = true;
+    uz::file_index idx{path, opts};
+    slassert(data == read_stream(idx, name));
+    auto stats = idx.get_stats();
+    slassert(1 == stats.opened_other);
+    slassert(static_cast<uint64_t>(idx.find_zip_entry(name).comp_length) == stats.comp_bytes_read);
+    slassert(data.length() == stats.uncomp_bytes_read);
+}
+
+void test_registry() {
+    slassert(nullptr != uz::find_codec(8).get());
+    slassert("deflate" == uz::find_codec(8)->name());
+    slassert(nullptr == uz::find_codec(0).get());
+    slassert(nullptr == uz::find_codec(xor_method).get());
+    for (uint16_t method : {0, 8}) {
+        bool thrown = false;
+        try {
+            uz::register_codec(method, std::make_shared<xor_codec>());
+        } catch (const uz::unzip_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+}
+
+void test_custom_codec() {
+    auto data = gen_data(100000);
+    write_zip("entry_codec_test_xor.zip", "data.txt", data, xor_method, xor_data(data));
+    {
+        uz::file_index idx{"entry_codec_test_xor.zip"};
+        bool thrown = false;
+        try {
+            uz::open_zip_entry(idx, "data.txt");
+        } catch (const uz::unzip_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+        auto res = uz::verify_archive(idx);
+        slassert(1 == res.failed_entries.size());
+    }
+    uz::register_codec(xor_method, std::make_shared<xor_codec>());
+    slassert("xor" == uz::find_codec(xor_method)->name());
+    check_entry("entry_codec_test_xor.zip", "data.txt", data);
+}
+
+void test_deflate_codec() {
+    uz::file_index idx{"../test/data/bundle.zip"};
+    auto desc = idx.find_zip_entry("bundle/bbbb.txt");
+    std::vector<char> comp;
+    comp.resize(static_cast<size_t>(desc.comp_length));
+    auto src = uz::open_zip_entry_data(idx, "bundle/bbbb.txt");
+    sl::io::read_exact(src, {comp.data(), comp.size()});
+    auto codec = uz::find_codec(8);
+    std::vector<char> out;
+    out.resize(static_cast<size_t>(desc.uncomp_length));
+    codec->decode({comp.data(), comp.size()}, {out.data(), out.size()});
+    slassert("bbbbbbbb\n" == std::string(out.data(), out.size()));
+    auto decoder = codec->open_decoder(uz::make_codec_source(uz::open_zip_entry_data(idx, "bundle/bbbb.txt")),
+            static_cast<uint64_t>(desc.uncomp_length));
+    std::string streamed;
+    std::array<char, 3> buf;
+    for (;;) {
+        auto read = decoder->read({buf.data(), buf.size()});
+        if (read <= 0) {
+            break;
+        }
+        streamed.append(buf.data(), static_cast<size_t>(read));
+    }
+    slassert("bbbbbbbb\n" == streamed);
+}
+
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+void test_zstd() {
+    slassert(nullptr != uz::find_codec(uz::zstd_method).get());
+    auto data = gen_data(1 << 20);
+    std::string comp;
+    comp.resize(ZSTD_compressBound(data.length()));
+    size_t len = ZSTD_compress(std::addressof(comp.front()), comp.length(), data.data(), data.length(), 3);
+    slassert(!ZSTD_isError(len));
+    comp.resize(len);
+    write_zip("entry_codec_test_zstd.zip", "data.txt", data, uz::zstd_method, comp);
+    check_entry("entry_codec_test_zstd.zip", "data.txt", data);
+}
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+
+int main() {
+    try {
+        test_registry();
+        test_custom_codec();
+        test_deflate_codec();
+#ifdef STATICLIB_UNZIP_WITH_ZSTD
+        test_zstd();
+#endif // STATICLIB_UNZIP_WITH_ZSTD
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
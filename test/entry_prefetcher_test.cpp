@@ -0,0 +1,169 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   entry_prefetcher_test.cpp
+ * Author: alex
+ *
+ * Created on October 17, 2026, 9:05 PM
+ */
+
+#include "staticlib/unzip/entry_prefetcher.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/unzip/operations.hpp"
+
+#include "zip_writer.hpp"
+
+
+namespace uz = staticlib::unzip;
+
+const size_t entries_count = 20;
+const size_t entry_len = 1000;
+
+std::string entry_name(size_t i) {
+    return "entry_" + std::to_string(i) + ".bin";
+}
+
+std::string entry_data(size_t i) {
+    return std::string(entry_len, static_cast<char>('a' + i));
+}
+
+// writes stored entries
+void write_zip(const std::string& path) {
+    std::vector<zip_writer::gen_entry> entries;
+    for (size_t i = 0; i < entries_count; i++) {
+        entries.emplace_back(entry_name(i), entry_data(i));
+    }
+    zip_writer::write_archive(path, entries);
+}
+
+std::vector<std::string> all_names() {
+    std::vector<std::string> res;
+    for (size_t i = 0; i < entries_count; i++) {
+        res.push_back(entry_name(i));
+    }
+    return res;
+}
+
+// entries being decompressed are counted when workers finish them
+void wait_stats(const uz::entry_prefetcher& pf, size_t bytes_buffered, uint64_t wasted) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (;;) {
+        auto stats = pf.get_stats();
+        if (bytes_buffered == stats.bytes_buffered && wasted == stats.wasted) {
+            break;
+        }
+        slassert(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+std::string read_entry(uz::entry_prefetcher& pf, const std::string& name) {
+    auto stream = uz::open_zip_entry(pf, name);
+    return std::string{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+}
+
+void test_sequential() {
+    uz::file_index idx{"entry_prefetcher_test.zip"};
+    uz::prefetch_options opts;
+    opts.buffer_budget = 5 * entry_len;
+    uz::entry_prefetcher pf{idx, opts};
+    pf.hint(all_names());
+    // workers stop when the budget is filled
+    wait_stats(pf, 5 * entry_len, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    slassert(5 * entry_len == pf.get_stats().bytes_buffered);
+    for (size_t i = 0; i < entries_count; i++) {
+        slassert(entry_data(i) == read_entry(pf, entry_name(i)));
+    }
+    auto stats = pf.get_stats();
+    slassert(stats.hits >= 5);
+    slassert(entries_count == stats.hits + stats.misses);
+    slassert(0 == stats.wasted);
+    slassert(0 == stats.bytes_buffered);
+}
+
+void test_wrong_hints() {
+    uz::file_index idx{"entry_prefetcher_test.zip"};
+    uz::prefetch_options opts;
+    opts.buffer_budget = 3 * entry_len;
+    uz::entry_prefetcher pf{idx, opts};
+    pf.hint(all_names());
+    wait_stats(pf, 3 * entry_len, 0);
+    // skipped entries are dropped and release the buffer
+    slassert(entry_data(10) == read_entry(pf, entry_name(10)));
+    slassert(nullptr == pf.take(entry_name(10)).get());
+    wait_stats(pf, 3 * entry_len, 3);
+    // already skipped entry is read from the index
+    slassert(entry_data(0) == read_entry(pf, entry_name(0)));
+    // entry not in hints
+    slassert(entry_data(15) == read_entry(pf, entry_name(15)));
+    slassert(entry_data(16) == read_entry(pf, entry_name(16)));
+    bool thrown = false;
+    try {
+        read_entry(pf, "fail.bin");
+    } catch (const uz::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_cancel() {
+    uz::file_index idx{"entry_prefetcher_test.zip"};
+    uz::prefetch_options opts;
+    opts.buffer_budget = 4 * entry_len;
+    opts.threads_count = 4;
+    uz::entry_prefetcher pf{idx, opts};
+    pf.hint(all_names());
+    wait_stats(pf, 4 * entry_len, 0);
+    pf.cancel();
+    wait_stats(pf, 0, 4);
+    slassert(nullptr == pf.take(entry_name(0)).get());
+    // new hints after cancel
+    std::vector<std::string> names;
+    names.push_back(entry_name(7));
+    names.push_back(entry_name(3));
+    pf.hint(names);
+    wait_stats(pf, 2 * entry_len, 4);
+    slassert(entry_data(7) == read_entry(pf, entry_name(7)));
+    slassert(entry_data(3) == read_entry(pf, entry_name(3)));
+    // destroyed with pending work
+    uz::entry_prefetcher pending{idx, opts};
+    pending.hint(all_names());
+}
+
+int main() {
+    try {
+        write_zip("entry_prefetcher_test.zip");
+        test_sequential();
+        test_wrong_hints();
+        test_cancel();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -28,10 +28,19 @@
 #include <string>
 #include <sstream>
 #include <array>
+#include <cstdio>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 
 #include "staticlib/io.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "zip_writer.hpp"
 
 void test_read_inflate() {
     sl::unzip::file_index idx{"../test/data/bundle.zip"};
@@ -44,6 +53,23 @@ void test_read_inflate() {
     slassert("bbbbbbbb\n" == out.str());
 }
 
+void test_open_by_id() {
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    uint32_t id = idx.find_entry_id("bundle/bbbb.txt");
+    for (size_t i = 0; i < 2; i++) {
+        auto ptr = sl::unzip::open_zip_entry(idx, id);
+        std::string str{std::istreambuf_iterator<char>(*ptr), std::istreambuf_iterator<char>()};
+        slassert("bbbbbbbb\n" == str);
+    }
+    bool thrown = false;
+    try {
+        sl::unzip::open_zip_entry(idx, sl::unzip::invalid_entry_id);
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
 void test_read_store() {
     sl::unzip::file_index idx{"../test/data/bundle.zip"};
     std::ostringstream out{};
@@ -69,11 +95,629 @@ void test_read_manual() {
     slassert("bye" == out.str());
 }
 
+void test_read_mapped() {
+    sl::unzip::file_index_options opts;
+    opts.memory_mapped = true;
+    sl::unzip::file_index idx{"../test/data/bundle.zip", opts};
+    slassert(idx.is_memory_mapped());
+    {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(idx, "bundle/bbbb.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+        slassert("bbbbbbbb\n" == out.str());
+    }
+    {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(idx, "bundle/aaa.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+        slassert("aaa\n" == out.str());
+    }
+}
+
+void test_view_store() {
+    sl::unzip::file_index_options opts;
+    opts.memory_mapped = true;
+    sl::unzip::file_index idx{"../test/data/bundle.zip", opts};
+    auto view = sl::unzip::view_zip_entry(idx, "bundle/aaa.txt");
+    slassert("aaa\n" == std::string(view.data(), view.size()));
+    bool thrown = false;
+    try {
+        sl::unzip::view_zip_entry(idx, "bundle/bbbb.txt");
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_read_concurrent() {
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; i++) {
+        threads.emplace_back([&idx, &failures, i] {
+            std::string name = 0 == i % 2 ? "bundle/aaa.txt" : "bundle/bbbb.txt";
+            std::string expected = 0 == i % 2 ? "aaa\n" : "bbbbbbbb\n";
+            for (size_t j = 0; j < 100; j++) {
+                std::ostringstream out{};
+                sl::io::streambuf_sink sink{out.rdbuf()};
+                auto ptr = sl::unzip::open_zip_entry(idx, name);
+                sl::io::streambuf_source src{ptr->rdbuf()};
+                sl::io::copy_all(src, sink);
+                if (expected != out.str()) {
+                    failures += 1;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(0 == failures.load());
+}
+
+void test_outlive_index() {
+    std::unique_ptr<std::istream> ptr;
+    {
+        sl::unzip::file_index idx{"../test/data/bundle.zip"};
+        ptr = sl::unzip::open_zip_entry(idx, "bundle/bbbb.txt");
+    }
+    std::ostringstream out{};
+    sl::io::streambuf_sink sink{out.rdbuf()};
+    sl::io::streambuf_source src{ptr->rdbuf()};
+    sl::io::copy_all(src, sink);
+    slassert("bbbbbbbb\n" == out.str());
+}
+
+void test_entry_cache() {
+    sl::unzip::file_index_options opts;
+    opts.entry_cache_budget = 1 << 20;
+    sl::unzip::file_index idx{"../test/data/bundle.zip", opts};
+    auto cache = idx.get_entry_cache();
+    slassert(nullptr != cache.get());
+    for (size_t i = 0; i < 3; i++) {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(idx, "bundle/bbbb.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+        slassert("bbbbbbbb\n" == out.str());
+    }
+    auto stats = cache->get_stats();
+    slassert(1 == stats.misses);
+    slassert(2 == stats.hits);
+    slassert(1 == stats.entries_count);
+    slassert(9 == stats.bytes_used);
+
+    // budget fits only one of the entries
+    sl::unzip::file_index_options small_opts;
+    small_opts.entry_cache_budget = 10;
+    small_opts.entry_cache_max_entry_size = 10;
+    sl::unzip::file_index small_idx{"../test/data/bundle.zip", small_opts};
+    sl::unzip::open_zip_entry(small_idx, "bundle/aaa.txt");
+    sl::unzip::open_zip_entry(small_idx, "bundle/bbbb.txt");
+    auto small_stats = small_idx.get_entry_cache()->get_stats();
+    slassert(1 == small_stats.evictions);
+    slassert(1 == small_stats.entries_count);
+
+    sl::unzip::file_index no_cache_idx{"../test/data/bundle.zip"};
+    slassert(nullptr == no_cache_idx.get_entry_cache().get());
+}
+
+void test_read_batch() {
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    std::vector<std::string> names = {"bundle/bbbb.txt", "bundle/aaa.txt"};
+    bool bbbb_first = idx.find_zip_entry("bundle/bbbb.txt").offset < idx.find_zip_entry("bundle/aaa.txt").offset;
+    std::vector<std::string> expected_order = bbbb_first ? names : std::vector<std::string>{names[1], names[0]};
+    sl::unzip::batch_options small;
+    small.max_read_size = 1;
+    // falls back to synchronous reads when "io_uring" is not available
+    sl::unzip::batch_options ring;
+    ring.io_queue_depth = 4;
+    sl::unzip::batch_options ring_small = ring;
+    ring_small.max_read_size = 320;
+    ring_small.max_gap = 0;
+    ring_small.io_buffer_budget = 1;
+    sl::unzip::batch_options ring_streamed = small;
+    ring_streamed.io_queue_depth = 4;
+    sl::unzip::file_index_options opts;
+    opts.memory_mapped = true;
+    sl::unzip::file_index idx_mapped{"../test/data/bundle.zip", opts};
+    std::vector<std::pair<const sl::unzip::file_index*, sl::unzip::batch_options>> variants = {
+        {std::addressof(idx), sl::unzip::batch_options()},
+        {std::addressof(idx), small},
+        {std::addressof(idx), ring},
+        {std::addressof(idx), ring_small},
+        {std::addressof(idx), ring_streamed},
+        {std::addressof(idx_mapped), sl::unzip::batch_options()}
+    };
+    for (auto& va : variants) {
+        std::vector<std::string> order;
+        std::vector<std::string> contents;
+        auto count = sl::unzip::read_entries_batch(*va.first, names, [&](const std::string& name, std::istream& stream) {
+            order.push_back(name);
+            std::ostringstream out{};
+            out << stream.rdbuf();
+            contents.push_back(out.str());
+        }, va.second);
+        slassert(2 == count);
+        slassert(expected_order == order);
+        for (size_t i = 0; i < order.size(); i++) {
+            slassert(("bundle/aaa.txt" == order[i] ? "aaa\n" : "bbbbbbbb\n") == contents[i]);
+        }
+    }
+    bool thrown = false;
+    try {
+        sl::unzip::read_entries_batch(idx, {"bundle/fail.txt"}, [](const std::string&, std::istream&) { });
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_stats() {
+    sl::unzip::file_index_options opts;
+    opts.collect_stats = true;
+    sl::unzip::file_index idx{"../test/data/bundle.zip", opts};
+    auto initial = idx.get_stats();
+    slassert(initial.cd_bytes_parsed > 0);
+    slassert(0 == initial.opened_stored + initial.opened_deflated);
+    for (size_t i = 0; i < 2; i++) {
+        for (auto name : {"bundle/aaa.txt", "bundle/bbbb.txt"}) {
+            std::ostringstream out{};
+            out << sl::unzip::open_zip_entry(idx, name)->rdbuf();
+        }
+    }
+    auto stats = idx.get_stats();
+    slassert(2 == stats.opened_stored);
+    slassert(2 == stats.opened_deflated);
+    slassert(0 == stats.opened_other);
+    slassert(2 * (4 + 9) == stats.uncomp_bytes_read);
+    auto aaa = idx.find_zip_entry("bundle/aaa.txt");
+    auto bbbb = idx.find_zip_entry("bundle/bbbb.txt");
+    slassert(static_cast<uint64_t>(2 * (aaa.comp_length + bbbb.comp_length)) == stats.comp_bytes_read);
+    uint64_t opens = 0;
+    for (auto count : stats.open_latency_histogram) {
+        opens += count;
+    }
+    slassert(4 == opens);
+    slassert(0 == stats.local_header_failures);
+
+    sl::unzip::file_index no_stats_idx{"../test/data/bundle.zip"};
+    sl::unzip::open_zip_entry(no_stats_idx, "bundle/aaa.txt");
+    slassert(0 == no_stats_idx.get_stats().opened_stored);
+    slassert(nullptr == no_stats_idx.get_stats_collector().get());
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream stream{path, std::ios::binary};
+    std::ostringstream out{};
+    out << stream.rdbuf();
+    return out.str();
+}
+
+void test_extract_all() {
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    sl::unzip::extract_options opts;
+    opts.threads_count = 2;
+    auto count = sl::unzip::extract_all(idx, "operations_test_extract_all", opts);
+    slassert(2 == count);
+    slassert("aaa\n" == read_file("operations_test_extract_all/bundle/aaa.txt"));
+    slassert("bbbbbbbb\n" == read_file("operations_test_extract_all/bundle/bbbb.txt"));
+
+    // falls back to streaming each entry when "io_uring" is not available
+    std::vector<zip_writer::gen_entry> entries;
+    for (size_t i = 0; i < 20; i++) {
+        entries.emplace_back("dir/" + std::to_string(i) + ".txt", std::string(i * 1000, 'a' + i % 26), 0 == i % 2);
+    }
+    zip_writer::write_archive("operations_test_extract_ring.zip", entries);
+    sl::unzip::file_index ring_idx{"operations_test_extract_ring.zip"};
+    sl::unzip::extract_options ring_opts;
+    ring_opts.threads_count = 3;
+    ring_opts.io_queue_depth = 4;
+    ring_opts.io_buffer_budget = 1;
+    slassert(entries.size() == sl::unzip::extract_all(ring_idx, "operations_test_extract_ring", ring_opts));
+    for (auto& en : entries) {
+        slassert(en.data == read_file("operations_test_extract_ring/" + en.name));
+    }
+
+    // entry with empty name is skipped, colon is allowed outside of windows
+    std::vector<zip_writer::gen_entry> names;
+    names.emplace_back("", "x");
+    names.emplace_back("a.txt", "a");
+#ifndef STATICLIB_WINDOWS
+    names.emplace_back("b:c.txt", "bc");
+#endif // STATICLIB_WINDOWS
+    zip_writer::write_archive("operations_test_extract_names.zip", names);
+    sl::unzip::file_index names_idx{"operations_test_extract_names.zip"};
+    slassert(names.size() - 1 == sl::unzip::extract_all(names_idx, "operations_test_extract_names"));
+    slassert("a" == read_file("operations_test_extract_names/a.txt"));
+#ifndef STATICLIB_WINDOWS
+    slassert("bc" == read_file("operations_test_extract_names/b:c.txt"));
+#endif // STATICLIB_WINDOWS
+
+    // parent directory references are rejected on all platforms
+    zip_writer::write_archive("operations_test_extract_parent.zip", {
+        zip_writer::gen_entry("../a.txt", "a")
+    });
+    sl::unzip::file_index parent_idx{"operations_test_extract_parent.zip"};
+    bool thrown = false;
+    try {
+        sl::unzip::extract_all(parent_idx, "operations_test_extract_parent");
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_extract_matching() {
+    sl::unzip::file_index idx{"../test/data/test.zip"};
+    auto count = sl::unzip::extract_matching(idx, "operations_test_extract_matching", [](const std::string& name) {
+        return 0 == name.find("bar/");
+    });
+    slassert(1 == count);
+    slassert("bye" == read_file("operations_test_extract_matching/bar/baz.txt"));
+    std::ifstream foo{"operations_test_extract_matching/foo.txt"};
+    slassert(!foo.is_open());
+}
+
+std::string gen_data(size_t len) {
+    std::string res;
+    res.reserve(len);
+    uint32_t state = 42;
+    while (res.length() < len) {
+        state = state * 1103515245 + 12345;
+        res += "line " + std::to_string(res.length()) + " " + std::to_string((state >> 16) % 1000) + "\n";
+    }
+    res.resize(len);
+    return res;
+}
+
+// single deflated entry archive
+void write_deflated_zip(const std::string& path, const std::string& name, const std::string& data,
+        bool deflated = true) {
+    zip_writer::write_archive(path, {zip_writer::gen_entry(name, data, deflated)});
+}
+
+std::string read_at(std::istream& stream, std::streamoff pos, size_t len) {
+    stream.clear();
+    stream.seekg(pos);
+    std::string res;
+    res.resize(len);
+    stream.read(std::addressof(res.front()), static_cast<std::streamsize>(len));
+    res.resize(static_cast<size_t>(stream.gcount()));
+    return res;
+}
+
+void test_seek_inflate() {
+    std::string data = gen_data(4 << 20);
+    write_deflated_zip("operations_test_seek.zip", "data.txt", data);
+    sl::unzip::file_index idx{"operations_test_seek.zip"};
+    // checkpoints are recorded during the first sequential pass
+    auto checkpoints = std::make_shared<sl::unzip::inflate_checkpoints>(256 << 10);
+    auto stream = sl::unzip::open_zip_entry_seekable(idx, "data.txt", checkpoints);
+    slassert(data.substr(1000, 100) == read_at(*stream, 1000, 100));
+    slassert(data.substr(3000000, 100) == read_at(*stream, 3000000, 100));
+    slassert(checkpoints->size() >= 8);
+    slassert(!checkpoints->is_complete());
+    slassert(data.substr(500000, 100) == read_at(*stream, 500000, 100));
+    slassert(data.substr(data.length() - 10) == read_at(*stream, data.length() - 10, 100));
+    slassert(checkpoints->is_complete());
+    stream->clear();
+    stream->seekg(0, std::ios_base::end);
+    slassert(static_cast<std::streamoff>(data.length()) == stream->tellg());
+    stream->seekg(-5, std::ios_base::cur);
+    std::string tail;
+    tail.resize(5);
+    stream->read(std::addressof(tail.front()), 5);
+    slassert(data.substr(data.length() - 5) == tail);
+
+    // index built on demand is reused by the other streams
+    auto built = sl::unzip::build_inflate_checkpoints(idx, "data.txt", 256 << 10);
+    slassert(built->is_complete());
+    slassert(built->size() >= 12);
+    bool not_found_thrown = false;
+    try {
+        sl::unzip::build_inflate_checkpoints(idx, "fail.txt");
+    } catch (const sl::unzip::unzip_exception&) {
+        not_found_thrown = true;
+    }
+    slassert(not_found_thrown);
+    std::vector<std::streamoff> positions = {4000000, 123, 2500000, 2500001, 1048576, 3999999};
+    sl::unzip::file_index_options opts;
+    opts.memory_mapped = true;
+    sl::unzip::file_index idx_mapped{"operations_test_seek.zip", opts};
+    auto st = sl::unzip::open_zip_entry_seekable(idx, "data.txt", built);
+    auto st_mapped = sl::unzip::open_zip_entry_seekable(idx_mapped, "data.txt", built);
+    for (auto pos : positions) {
+        std::string expected = data.substr(static_cast<size_t>(pos), 200);
+        slassert(expected == read_at(*st, pos, 200));
+        slassert(expected == read_at(*st_mapped, pos, 200));
+    }
+    std::remove("operations_test_seek.zip");
+}
+
+void test_seek_store() {
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    auto stream = sl::unzip::open_zip_entry_seekable(idx, "bundle/aaa.txt");
+    slassert("a\n" == read_at(*stream, 2, 10));
+    slassert("aaa\n" == read_at(*stream, 0, 10));
+    stream->clear();
+    stream->seekg(-1, std::ios_base::end);
+    slassert(3 == stream->tellg());
+    auto inflated = sl::unzip::open_zip_entry_seekable(idx, "bundle/bbbb.txt");
+    slassert("bbb\n" == read_at(*inflated, 5, 10));
+    slassert("bbbbbbbb\n" == read_at(*inflated, 0, 10));
+}
+
+void test_read_entry() {
+    for (bool mapped : {false, true}) {
+        sl::unzip::file_index_options opts;
+        opts.memory_mapped = mapped;
+        sl::unzip::file_index idx{"../test/data/bundle.zip", opts};
+        auto bbbb = sl::unzip::read_entry(idx, "bundle/bbbb.txt");
+        slassert("bbbbbbbb\n" == std::string(bbbb.data(), bbbb.size()));
+        std::array<char, 16> buf;
+        size_t len = sl::unzip::read_entry_into(idx, "bundle/aaa.txt", {buf.data(), buf.size()});
+        slassert(4 == len);
+        slassert("aaa\n" == std::string(buf.data(), len));
+        bool thrown = false;
+        try {
+            sl::unzip::read_entry_into(idx, "bundle/bbbb.txt", {buf.data(), 4});
+        } catch (const sl::unzip::unzip_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+    auto data = gen_data(1 << 20);
+    write_deflated_zip("operations_test_read_entry.zip", "data.txt", data);
+    sl::unzip::file_index idx{"operations_test_read_entry.zip"};
+    auto read = sl::unzip::read_entry(idx, "data.txt");
+    slassert(data == std::string(read.data(), read.size()));
+}
+
+void test_entry_source() {
+    namespace zcm = sl::compress;
+    sl::unzip::file_index idx{"../test/data/bundle.zip"};
+    {
+        auto desc = idx.find_zip_entry("bundle/aaa.txt");
+        auto src = sl::unzip::make_entry_source<zcm::zip_compression_method::store>(
+                sl::unzip::open_zip_entry_data(idx, "bundle/aaa.txt"), desc);
+        auto moved = std::move(src);
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        sl::io::copy_all(moved, sink);
+        slassert("aaa\n" == out.str());
+    }
+    {
+        auto desc = idx.find_zip_entry("bundle/bbbb.txt");
+        auto src = sl::unzip::make_entry_source<zcm::zip_compression_method::deflate>(
+                sl::unzip::open_zip_entry_data(idx, "bundle/bbbb.txt"), desc);
+        auto moved = std::move(src);
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        sl::io::copy_all(moved, sink);
+        slassert("bbbbbbbb\n" == out.str());
+        // inflater owns the compressed source, it stays reachable after move
+        char ch = '\0';
+        slassert(std::char_traits<char>::eof() == moved.get_source().read({std::addressof(ch), 1}));
+    }
+    bool thrown = false;
+    try {
+        sl::unzip::make_entry_source<zcm::zip_compression_method::store>(
+                sl::unzip::open_zip_entry_data(idx, "bundle/bbbb.txt"), idx.find_zip_entry("bundle/bbbb.txt"));
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_verify_crc() {
+    sl::unzip::file_index_options opts;
+    opts.verify_crc = true;
+    sl::unzip::file_index bundle{"../test/data/bundle.zip", opts};
+    slassert(bundle.is_crc_verified());
+    slassert(0x77f85d95 == bundle.find_zip_entry("bundle/aaa.txt").crc);
+    auto bbbb = sl::unzip::read_entry(bundle, "bundle/bbbb.txt");
+    slassert("bbbbbbbb\n" == std::string(bbbb.data(), bbbb.size()));
+    {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(bundle, "bundle/aaa.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+        slassert("aaa\n" == out.str());
+    }
+    // CRC values are zeroed in this file
+    sl::unzip::file_index idx{"../test/data/test.zip", opts};
+    bool thrown = false;
+    try {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(idx, "foo.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        sl::unzip::read_entry(idx, "bar/baz.txt");
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+
+    // deflate stream that ends before the uncompressed length is reached
+    std::string data = gen_data(10000);
+    zip_writer::write_archive("operations_test_short.zip", {zip_writer::gen_entry("short.txt", data, 8,
+            zip_writer::deflate_data(data.substr(0, 5000)))});
+    sl::unzip::file_index short_idx{"operations_test_short.zip", opts};
+    bool short_thrown = false;
+    try {
+        std::ostringstream out{};
+        sl::io::streambuf_sink sink{out.rdbuf()};
+        auto ptr = sl::unzip::open_zip_entry(short_idx, "short.txt");
+        sl::io::streambuf_source src{ptr->rdbuf()};
+        sl::io::copy_all(src, sink);
+    } catch (const sl::unzip::unzip_exception& e) {
+        short_thrown = std::string(e.what()).find("Unexpected end of data") != std::string::npos;
+    }
+    slassert(short_thrown);
+}
+
+void test_verify_archive() {
+    for (bool mapped : {false, true}) {
+        sl::unzip::file_index_options opts;
+        opts.memory_mapped = mapped;
+        sl::unzip::file_index bundle{"../test/data/bundle.zip", opts};
+        auto res = sl::unzip::verify_archive(bundle);
+        slassert(2 == res.entries_count);
+        slassert(13 == res.bytes_count);
+        slassert(res.failed_entries.empty());
+        sl::unzip::file_index idx{"../test/data/test.zip", opts};
+        sl::unzip::verify_options vopts;
+        vopts.threads_count = 2;
+        auto failed = sl::unzip::verify_archive(idx, vopts);
+        slassert(2 == failed.entries_count);
+        slassert(2 == failed.failed_entries.size());
+        slassert("bar/baz.txt" == failed.failed_entries[0]);
+        slassert("foo.txt" == failed.failed_entries[1]);
+    }
+    // entry with empty name is skipped
+    zip_writer::write_archive("operations_test_empty_name.zip", {
+        zip_writer::gen_entry("", "x"),
+        zip_writer::gen_entry("a.txt", "a")
+    });
+    sl::unzip::file_index empty_name{"operations_test_empty_name.zip"};
+    auto res = sl::unzip::verify_archive(empty_name);
+    slassert(1 == res.entries_count);
+    slassert(res.failed_entries.empty());
+
+    // local header failures are counted the same way as on reads
+    std::string contents = zip_writer::make_archive({
+        zip_writer::gen_entry("a.txt", "a"),
+        zip_writer::gen_entry("b.txt", "b")
+    });
+    contents[0] = 'X';
+    {
+        std::ofstream out{"operations_test_bad_header.zip", std::ios::binary};
+        out << contents;
+    }
+    sl::unzip::file_index_options stats_opts;
+    stats_opts.collect_stats = true;
+    sl::unzip::file_index bad_header{"operations_test_bad_header.zip", stats_opts};
+    auto bad_res = sl::unzip::verify_archive(bad_header);
+    slassert(1 == bad_res.failed_entries.size());
+    slassert("a.txt" == bad_res.failed_entries[0]);
+    slassert(1 == bad_header.get_stats().local_header_failures);
+}
+
+void test_memory_index() {
+    std::string contents;
+    {
+        auto reader = sl::unzip::make_mapped_reader("../test/data/bundle.zip");
+        contents.assign(reader->data().data(), reader->data().size());
+    }
+    sl::unzip::file_index idx{sl::unzip::make_memory_reader({contents.data(), contents.length()}, "bundle")};
+    slassert(idx.is_memory_mapped());
+    slassert("bundle" == idx.get_zip_file_path());
+    auto bbbb = sl::unzip::read_entry(idx, "bundle/bbbb.txt");
+    slassert("bbbbbbbb\n" == std::string(bbbb.data(), bbbb.size()));
+    // stored entries point into the caller buffer
+    auto view = sl::unzip::view_zip_entry(idx, "bundle/aaa.txt");
+    slassert(view.data() > contents.data() && view.data() < contents.data() + contents.length());
+    slassert("aaa\n" == std::string(view.data(), view.size()));
+    auto raw = sl::unzip::view_zip_entry_data(idx, "bundle/bbbb.txt");
+    auto src = sl::unzip::make_entry_source<sl::compress::zip_compression_method::deflate>(
+            sl::io::array_source(raw.data(), raw.size()), idx.find_zip_entry("bundle/bbbb.txt"));
+    std::ostringstream out{};
+    sl::io::streambuf_sink sink{out.rdbuf()};
+    sl::io::copy_all(src, sink);
+    slassert("bbbbbbbb\n" == out.str());
+
+    auto size = static_cast<uint64_t>(contents.length());
+    sl::unzip::file_index src_idx{sl::unzip::make_source_reader(
+            sl::tinydir::file_source("../test/data/bundle.zip"), size)};
+    slassert(!src_idx.is_memory_mapped());
+    slassert(2 == sl::unzip::verify_archive(src_idx).entries_count);
+    auto stream = sl::unzip::open_zip_entry(src_idx, "bundle/bbbb.txt");
+    std::string streamed{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+    slassert("bbbbbbbb\n" == streamed);
+    bool thrown = false;
+    try {
+        sl::unzip::view_zip_entry_data(src_idx, "bundle/bbbb.txt");
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_nested_index() {
+    std::string inner = read_file("../test/data/bundle.zip");
+    write_deflated_zip("operations_test_nested_stored.zip", "inner.zip", inner, false);
+    write_deflated_zip("operations_test_nested_deflated.zip", "inner.zip", inner);
+    for (bool mapped : {false, true}) {
+        sl::unzip::file_index_options opts;
+        opts.memory_mapped = mapped;
+        sl::unzip::file_index outer{"operations_test_nested_stored.zip", opts};
+        auto nested = sl::unzip::open_nested_index(outer, "inner.zip");
+        slassert("operations_test_nested_stored.zip/inner.zip" == nested.get_zip_file_path());
+        slassert(mapped == nested.is_memory_mapped());
+        auto bbbb = sl::unzip::read_entry(nested, "bundle/bbbb.txt");
+        slassert("bbbbbbbb\n" == std::string(bbbb.data(), bbbb.size()));
+        slassert(0 == sl::unzip::verify_archive(nested).failed_entries.size());
+        if (mapped) {
+            // nested entries point into the outer mapping
+            auto outer_data = outer.get_archive_reader()->data();
+            auto view = sl::unzip::view_zip_entry(nested, "bundle/aaa.txt");
+            slassert(view.data() > outer_data.data() && view.data() < outer_data.data() + outer_data.size());
+            slassert("aaa\n" == std::string(view.data(), view.size()));
+        }
+    }
+    sl::unzip::file_index outer{"operations_test_nested_deflated.zip"};
+    auto nested = sl::unzip::open_nested_index(outer, "inner.zip");
+    slassert(nested.is_memory_mapped());
+    auto stream = sl::unzip::open_zip_entry(nested, "bundle/aaa.txt");
+    std::string aaa{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+    slassert("aaa\n" == aaa);
+    bool thrown = false;
+    try {
+        sl::unzip::file_index idx{"../test/data/bundle.zip"};
+        sl::unzip::open_nested_index(idx, "bundle/aaa.txt");
+    } catch (const sl::unzip::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
 int main() {
     try {
         test_read_inflate();
+        test_open_by_id();
         test_read_store();
         test_read_manual();
+        test_read_mapped();
+        test_view_store();
+        test_read_concurrent();
+        test_outlive_index();
+        test_entry_cache();
+        test_read_batch();
+        test_stats();
+        test_extract_all();
+        test_extract_matching();
+        test_seek_inflate();
+        test_seek_store();
+        test_read_entry();
+        test_entry_source();
+        test_verify_crc();
+        test_verify_archive();
+        test_memory_index();
+        test_nested_index();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
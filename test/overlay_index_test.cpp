@@ -0,0 +1,154 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   overlay_index_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:40 AM
+ */
+
+#include "staticlib/unzip/overlay_index.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/unzip/operations.hpp"
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "zip_writer.hpp"
+
+namespace uz = staticlib::unzip;
+
+// builds archive with stored entries in memory
+std::shared_ptr<uz::archive_reader> make_zip(const std::vector<std::pair<std::string, std::string>>& entries,
+        const std::string& name) {
+    std::vector<zip_writer::gen_entry> gen;
+    for (auto& en : entries) {
+        gen.emplace_back(en.first, en.second);
+    }
+    auto data = zip_writer::make_archive(gen);
+    auto vec = std::make_shared<std::vector<char>>(data.begin(), data.end());
+    return uz::make_memory_reader(std::shared_ptr<const std::vector<char>>(std::move(vec)), name);
+}
+
+std::string read_stream(const uz::overlay_index& overlay, const std::string& name) {
+    auto stream = uz::open_zip_entry(overlay, name);
+    return std::string{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+}
+
+std::string to_string(sl::io::span<const char> span) {
+    return std::string(span.data(), span.size());
+}
+
+uz::overlay_index make_overlay() {
+    std::vector<uz::file_index> layers;
+    layers.emplace_back(make_zip({
+        {"foo.txt", "patched"},
+        {"bundle/", ""},
+        {"bundle/ccc.txt", "ccc"}
+    }, "patch"));
+    layers.emplace_back("../test/data/test.zip");
+    layers.emplace_back("../test/data/bundle.zip");
+    return uz::overlay_index(std::move(layers));
+}
+
+void test_lookup() {
+    auto overlay = make_overlay();
+    slassert(3 == overlay.get_layers_count());
+    slassert("patch" == overlay.get_layer(0).get_zip_file_path());
+    auto foo = overlay.find_entry("foo.txt");
+    slassert(!foo.is_empty());
+    slassert(0 == foo.layer);
+    slassert(0 == foo.id);
+    slassert(7 == foo.entry.uncomp_length);
+    auto baz = overlay.find_entry("bar/baz.txt");
+    slassert(1 == baz.layer);
+    slassert(1 == baz.id);
+    auto aaa = overlay.find_entry("bundle/aaa.txt");
+    slassert(2 == aaa.layer);
+    slassert(0x77f85d95 == aaa.entry.crc);
+    slassert(overlay.find_entry("fail").is_empty());
+    slassert(overlay.find_entry("bundle/").is_empty());
+    // patched foo.txt and repeated bundle/ are not counted
+    slassert(6 == overlay.get_entries_count());
+    for (uint32_t id = 0; id < overlay.get_entries_count(); id++) {
+        auto en = overlay.get_entry(id);
+        auto name = to_string(overlay.get_entry_name(id));
+        slassert(name == overlay.get_layer(en.layer).get_entries()[en.id]);
+    }
+    bool thrown = false;
+    try {
+        overlay.get_entry(6);
+    } catch (const uz::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_open() {
+    auto overlay = make_overlay();
+    slassert("patched" == read_stream(overlay, "foo.txt"));
+    slassert("bye" == read_stream(overlay, "bar/baz.txt"));
+    slassert("ccc" == read_stream(overlay, "bundle/ccc.txt"));
+    slassert("aaa\n" == read_stream(overlay, "bundle/aaa.txt"));
+    slassert("bbbbbbbb\n" == read_stream(overlay, "bundle/bbbb.txt"));
+    bool thrown = false;
+    try {
+        uz::open_zip_entry(overlay, "fail");
+    } catch (const uz::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_listing() {
+    auto overlay = make_overlay();
+    auto bundle = overlay.list_prefix("bundle/");
+    slassert(4 == bundle.size());
+    slassert("bundle/" == to_string(overlay.get_entry_name(bundle.data()[0])));
+    slassert("bundle/aaa.txt" == to_string(overlay.get_entry_name(bundle.data()[1])));
+    slassert("bundle/bbbb.txt" == to_string(overlay.get_entry_name(bundle.data()[2])));
+    slassert("bundle/ccc.txt" == to_string(overlay.get_entry_name(bundle.data()[3])));
+    slassert(6 == overlay.list_prefix("").size());
+    auto root = overlay.list_directory("");
+    slassert(3 == root.size());
+    slassert("bar/" == to_string(root[0]));
+    slassert("bundle/" == to_string(root[1]));
+    slassert("foo.txt" == to_string(root[2]));
+    slassert(3 == overlay.list_directory("bundle").size());
+    auto txt = overlay.list_glob("**/*.txt");
+    slassert(5 == txt.size());
+}
+
+int main() {
+    try {
+        test_lookup();
+        test_open();
+        test_listing();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   stream_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:05 AM
+ */
+
+#include "staticlib/unzip/stream_reader.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "zlib.h"
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/unzip/file_index.hpp"
+#include "staticlib/unzip/operations.hpp"
+#include "staticlib/unzip/unzip_exception.hpp"
+
+#include "zip_writer.hpp"
+
+namespace uz = staticlib::unzip;
+
+namespace { // anonymous
+
+using zip_writer::write_le;
+
+struct test_entry {
+    std::string name;
+    std::string data;
+    bool deflate;
+    bool descriptor;
+    bool zip64;
+};
+
+// returns data in small uneven pieces, like a network connection
+class trickle_source : public uz::codec_source {
+    std::string data;
+    size_t pos = 0;
+    size_t step = 0;
+
+public:
+    explicit trickle_source(std::string data) :
+    data(std::move(data)) { }
+
+    std::streamsize read(sl::io::span<char> span) override {
+        if (pos >= data.length()) {
+            return std::char_traits<char>::eof();
+        }
+        step = step % 7 + 1;
+        size_t len = std::min(std::min(span.size(), step), data.length() - pos);
+        std::memcpy(span.data(), data.data() + pos, len);
+        pos += len;
+        return static_cast<std::streamsize>(len);
+    }
+};
+
+// builds local headers and data as written by the streaming archivers,
+// central directory is not needed by the reader, only its end record is written
+std::string make_stream_zip(const std::vector<test_entry>& entries, uint32_t crc_xor = 0) {
+    std::ostringstream out;
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto& en = entries[i];
+        std::string payload = en.deflate ? zip_writer::deflate_data(en.data) : en.data;
+        uint32_t crc = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef*>(en.data.data()),
+                static_cast<uInt>(en.data.length()))) ^ crc_xor;
+        bool sizes_in_header = !en.descriptor;
+        write_le(out, 0x04034b50, 4);
+        write_le(out, en.zip64 ? 45 : 20, 2);
+        write_le(out, en.descriptor ? 8 : 0, 2);
+        write_le(out, en.deflate ? 8 : 0, 2);
+        write_le(out, 0, 4);
+        write_le(out, en.descriptor ? 0 : crc, 4);
+        if (en.zip64) {
+            write_le(out, 0xffffffff, 4);
+            write_le(out, 0xffffffff, 4);
+        } else {
+            write_le(out, sizes_in_header ? payload.length() : 0, 4);
+            write_le(out, sizes_in_header ? en.data.length() : 0, 4);
+        }
+        write_le(out, en.name.length(), 2);
+        write_le(out, en.zip64 ? 20 : 0, 2);
+        out << en.name;
+        if (en.zip64) {
+            write_le(out, 0x0001, 2);
+            write_le(out, 16, 2);
+            write_le(out, sizes_in_header ? en.data.length() : 0, 8);
+            write_le(out, sizes_in_header ? payload.length() : 0, 8);
+        }
+        out << payload;
+        if (en.descriptor) {
+            // signature is optional
+            if (0 == i % 2) {
+                write_le(out, 0x08074b50, 4);
+            }
+            write_le(out, crc, 4);
+            write_le(out, payload.length(), en.zip64 ? 8 : 4);
+            write_le(out, en.data.length(), en.zip64 ? 8 : 4);
+        }
+    }
+    write_le(out, 0x06054b50, 4);
+    write_le(out, 0, 8);
+    write_le(out, 0, 8);
+    write_le(out, 0, 2);
+    return out.str();
+}
+
+std::vector<test_entry> make_entries() {
+    std::string text;
+    for (size_t i = 0; i < 2000; i++) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    return {
+        {"text.txt", text, true, true, false},
+        {"stored.txt", "hello", false, false, false},
+        {"dir/", "", false, true, false},
+        {"dir/short.txt", "bye", true, true, false},
+        {"dir/zip64.txt", text.substr(0, 5000), true, true, true},
+        {"deflated.txt", text.substr(100, 300), true, false, false},
+        // stored data is delimited by the descriptor, fake descriptor with wrong CRC-32 is data
+        {"stored_descriptor.txt", std::string("xxPK\x07\x08\0\0\0\0\x02\0\0\0\x02\0\0\0yy", 20) + text,
+                false, true, false}
+    };
+}
+
+std::map<std::string, std::string> read_all_entries(uz::codec_source& src) {
+    std::map<std::string, std::string> res;
+    uz::read_zip_stream(src, [&](const uz::stream_entry& en, std::istream& stream) {
+        res[en.name] = std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    });
+    return res;
+}
+
+} // namespace
+
+void test_files() {
+    for (auto path : {"../test/data/test.zip", "../test/data/bundle.zip"}) {
+        uz::file_index idx{path};
+        std::ifstream file{path, std::ios::binary};
+        std::vector<std::string> names;
+        auto count = uz::read_zip_stream(file, [&](const uz::stream_entry& en, std::istream& stream) {
+            std::string data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+            if ('/' == en.name.back()) {
+                // directories are not indexed
+                slassert(data.empty());
+                return;
+            }
+            names.push_back(en.name);
+            auto expected = uz::open_zip_entry(idx, en.name);
+            slassert(std::string(std::istreambuf_iterator<char>(*expected), std::istreambuf_iterator<char>()) == data);
+        });
+        slassert(count >= names.size());
+        std::vector<std::string> indexed;
+        for (auto& name : idx.get_entries()) {
+            if ('/' != name.back()) {
+                indexed.push_back(name);
+            }
+        }
+        std::sort(indexed.begin(), indexed.end());
+        std::sort(names.begin(), names.end());
+        slassert(indexed == names);
+    }
+}
+
+void test_data_descriptors() {
+    auto entries = make_entries();
+    trickle_source src{make_stream_zip(entries)};
+    std::vector<uz::stream_entry> seen;
+    std::map<std::string, std::string> contents;
+    uz::stream_options opts;
+    opts.buffer_size = 16;
+    auto count = uz::read_zip_stream(src, [&](const uz::stream_entry& en, std::istream& stream) {
+        seen.push_back(en);
+        contents[en.name] = std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    }, opts);
+    slassert(entries.size() == count);
+    for (size_t i = 0; i < entries.size(); i++) {
+        slassert(entries[i].name == seen[i].name);
+        slassert(entries[i].descriptor == seen[i].has_data_descriptor());
+        slassert(entries[i].data == contents[entries[i].name]);
+    }
+    slassert(0 == seen[0].uncomp_length);
+    slassert(5 == seen[1].uncomp_length);
+    slassert(8 == seen[0].comp_method);
+
+    // unread entries are skipped
+    trickle_source partial{make_stream_zip(entries)};
+    std::string short_data;
+    auto partial_count = uz::read_zip_stream(partial, [&](const uz::stream_entry& en, std::istream& stream) {
+        if ("dir/short.txt" == en.name) {
+            short_data = std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+        } else if ("text.txt" == en.name) {
+            char buf[3];
+            stream.read(buf, sizeof(buf));
+        }
+    });
+    slassert(entries.size() == partial_count);
+    slassert("bye" == short_data);
+}
+
+void test_errors() {
+    auto entries = make_entries();
+    bool crc_thrown = false;
+    try {
+        trickle_source src{make_stream_zip(entries, 1)};
+        uz::stream_options verify;
+        verify.verify_crc = true;
+        // mismatch is reported even when the data is not read by the callback
+        uz::read_zip_stream(src, [](const uz::stream_entry&, std::istream&) { }, verify);
+    } catch (const uz::unzip_exception& e) {
+        crc_thrown = std::string(e.what()).find("CRC-32 mismatch") != std::string::npos;
+    }
+    slassert(crc_thrown);
+
+    auto data = make_stream_zip(entries);
+    bool truncated_thrown = false;
+    try {
+        trickle_source src{data.substr(0, data.length() / 2)};
+        read_all_entries(src);
+    } catch (const uz::unzip_exception&) {
+        truncated_thrown = true;
+    }
+    slassert(truncated_thrown);
+
+    bool signature_thrown = false;
+    try {
+        trickle_source src{"PK\x05\x05 garbage"};
+        read_all_entries(src);
+    } catch (const uz::unzip_exception&) {
+        signature_thrown = true;
+    }
+    slassert(signature_thrown);
+
+    // CRC-32 is not checked by default
+    trickle_source skipped{make_stream_zip(entries, 1)};
+    slassert(entries.size() == uz::read_zip_stream(skipped, [](const uz::stream_entry&, std::istream&) { }));
+}
+
+int main() {
+    try {
+        test_files();
+        test_data_descriptors();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -23,10 +23,22 @@
 
 #include "staticlib/unzip/file_index.hpp"
 
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 
+#include "staticlib/unzip/operations.hpp"
+
+#include "zip_writer.hpp"
+
 
 namespace uz = staticlib::unzip;
 
@@ -49,9 +61,460 @@ void test_entries() {
     slassert(0 == desc_fail.comp_method);    
 }
 
+using zip_writer::gen_entry;
+using zip_writer::write_le;
+
+// writes stored entries, Zip64 fields are used only for overflowing values
+void write_zip64(const std::string& path, const std::vector<gen_entry>& entries,
+        const std::string& comment = "") {
+    zip_writer::archive_options opts;
+    opts.zip64 = true;
+    opts.comment = comment;
+    zip_writer::write_archive(path, entries, opts);
+}
+
+void test_zip64_many_entries() {
+    std::vector<gen_entry> entries;
+    for (size_t i = 0; i < 70000; i++) {
+        std::ostringstream name{};
+        name << "dir/" << i << ".txt";
+        entries.emplace_back(name.str(), "x");
+    }
+    write_zip64("unzip_file_index_test_many.zip", entries);
+    uz::file_index idx{"unzip_file_index_test_many.zip"};
+    slassert(70000 == idx.get_entries().size());
+    slassert("dir/69999.txt" == idx.get_entries().back());
+    auto desc = idx.find_zip_entry("dir/69999.txt");
+    slassert(1 == desc.uncomp_length);
+    slassert(desc.offset > 0);
+}
+
+void check_same_index(const uz::file_index& expected, const uz::file_index& actual) {
+    slassert(expected.get_entries() == actual.get_entries());
+    for (uint32_t id = 0; id < expected.get_entries().size(); id++) {
+        auto en_expected = expected.get_zip_entry(id);
+        auto en_actual = actual.get_zip_entry(id);
+        slassert(en_expected.offset == en_actual.offset);
+        slassert(en_expected.comp_length == en_actual.comp_length);
+        slassert(en_expected.uncomp_length == en_actual.uncomp_length);
+        slassert(en_expected.comp_method == en_actual.comp_method);
+        slassert(en_expected.crc == en_actual.crc);
+        slassert(id == actual.find_entry_id(expected.get_entries()[id]) ||
+                '/' == expected.get_entries()[id].back());
+    }
+}
+
+void test_parallel_cd() {
+    // written by "test_zip64_many_entries"
+    uz::file_index_options seq_opts;
+    seq_opts.collect_stats = true;
+    uz::file_index seq{"unzip_file_index_test_many.zip", seq_opts};
+    for (bool mapped : {false, true}) {
+        for (size_t threads : {0, 3}) {
+            uz::file_index_options opts;
+            opts.memory_mapped = mapped;
+            opts.cd_threads_count = threads;
+            opts.collect_stats = true;
+            uz::file_index idx{"unzip_file_index_test_many.zip", opts};
+            check_same_index(seq, idx);
+            slassert(seq.get_stats().cd_bytes_parsed == idx.get_stats().cd_bytes_parsed);
+        }
+    }
+    std::vector<gen_entry> entries;
+    for (size_t i = 0; i < 5000; i++) {
+        entries.emplace_back("dup/" + std::to_string(i % 4999) + ".txt", "x");
+    }
+    write_zip64("unzip_file_index_test_dup.zip", entries);
+    uz::file_index_options opts;
+    opts.cd_threads_count = 4;
+    bool thrown = false;
+    try {
+        uz::file_index idx{"unzip_file_index_test_dup.zip", opts};
+    } catch (const uz::unzip_exception& e) {
+        thrown = std::string(e.what()).find("dup/0.txt") != std::string::npos;
+    }
+    slassert(thrown);
+#ifndef STATICLIB_WINDOWS
+    // sizes and offsets in Zip64 extra fields
+    entries.clear();
+    entries.emplace_back("big.bin", "", static_cast<uint64_t>(5) << 30);
+    for (size_t i = 0; i < 5000; i++) {
+        entries.emplace_back("far/" + std::to_string(i) + ".txt", std::to_string(i));
+    }
+    write_zip64("unzip_file_index_test_far.zip", entries);
+    uz::file_index far_seq{"unzip_file_index_test_far.zip"};
+    uz::file_index far{"unzip_file_index_test_far.zip", opts};
+    check_same_index(far_seq, far);
+    slassert(far.find_zip_entry("far/4999.txt").offset > (static_cast<int64_t>(5) << 30));
+    auto stream = uz::open_zip_entry(far, "far/4999.txt");
+    std::string str{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+    slassert("4999" == str);
+#endif // !STATICLIB_WINDOWS
+}
+
+// overwrites the bytes that follow the first occurrence of the marker within the file tail
+void patch_tail(const std::string& path, const std::string& marker, size_t skip, uint64_t val, size_t len) {
+    std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+    file.seekg(0, std::ios::end);
+    auto size = static_cast<std::streamoff>(file.tellg());
+    std::streamoff tail_offset = size > 4096 ? size - 4096 : 0;
+    file.seekg(tail_offset);
+    std::string tail{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    auto pos = tail.find(marker);
+    slassert(std::string::npos != pos);
+    file.clear();
+    file.seekp(tail_offset + static_cast<std::streamoff>(pos + marker.length() + skip));
+    write_le(file, val, len);
+}
+
+#ifndef STATICLIB_WINDOWS
+// relies on sparse files support
+void test_zip64_large() {
+    const uint64_t big_len = (static_cast<uint64_t>(5) << 30);
+    std::vector<gen_entry> entries;
+    entries.emplace_back("big.bin", "", big_len);
+    entries.emplace_back("small.txt", "hello");
+    write_zip64("unzip_file_index_test_large.zip", entries);
+    uz::file_index idx{"unzip_file_index_test_large.zip"};
+    auto desc_big = idx.find_zip_entry("big.bin");
+    slassert(0 == desc_big.offset);
+    slassert(static_cast<int64_t>(big_len) == desc_big.comp_length);
+    slassert(static_cast<int64_t>(big_len) == desc_big.uncomp_length);
+    auto desc_small = idx.find_zip_entry("small.txt");
+    slassert(desc_small.offset > static_cast<int64_t>(big_len));
+    slassert(5 == desc_small.uncomp_length);
+    auto stream = uz::open_zip_entry(idx, "small.txt");
+    std::string str{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+    slassert("hello" == str);
+}
+
+void test_invalid_zip64() {
+    // written by "test_zip64_large"
+    patch_tail("unzip_file_index_test_large.zip", std::string("big.bin\x01\x00", 9), 2, 0xffffffffffffffff, 8);
+    bool length_thrown = false;
+    try {
+        uz::file_index idx{"unzip_file_index_test_large.zip"};
+    } catch (const uz::unzip_exception& e) {
+        length_thrown = std::string(e.what()).find("Zip64 extended information") != std::string::npos;
+    }
+    slassert(length_thrown);
+
+    // records count is not trusted for allocations
+    std::vector<gen_entry> entries;
+    for (size_t i = 0; i < 5000; i++) {
+        entries.emplace_back(std::to_string(i) + ".txt", "x");
+    }
+    write_zip64("unzip_file_index_test_count.zip", entries);
+    for (size_t skip : {20, 28}) {
+        patch_tail("unzip_file_index_test_count.zip", "PK\x06\x06", skip, static_cast<uint64_t>(1) << 60, 8);
+    }
+    for (size_t threads : {1, 4}) {
+        uz::file_index_options opts;
+        opts.cd_threads_count = threads;
+        bool count_thrown = false;
+        try {
+            uz::file_index idx{"unzip_file_index_test_count.zip", opts};
+        } catch (const uz::unzip_exception&) {
+            count_thrown = true;
+        }
+        slassert(count_thrown);
+    }
+}
+#endif // !STATICLIB_WINDOWS
+
+void test_index_cache() {
+    std::vector<gen_entry> entries;
+    entries.emplace_back("foo/", "");
+    entries.emplace_back("foo/bar.txt", "bar");
+    entries.emplace_back("baz.txt", "baz");
+    write_zip64("unzip_file_index_test_cache.zip", entries);
+    std::remove("unzip_file_index_test_cache.idx");
+    uz::file_index_options opts;
+    opts.index_cache_path = "unzip_file_index_test_cache.idx";
+    // parse and write cache
+    {
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(3 == idx.get_entries().size());
+        std::ifstream cache{"unzip_file_index_test_cache.idx"};
+        slassert(cache.is_open());
+    }
+    // load from cache
+    {
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(3 == idx.get_entries().size());
+        slassert("foo/" == idx.get_entries()[0]);
+        slassert("baz.txt" == idx.get_entries()[2]);
+        slassert(3 == idx.find_zip_entry("foo/bar.txt").uncomp_length);
+        slassert(-1 == idx.find_zip_entry("foo/").offset);
+        auto stream = uz::open_zip_entry(idx, "baz.txt");
+        std::string str{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+        slassert("baz" == str);
+    }
+    // stale cache
+    entries.emplace_back("new.txt", "new");
+    write_zip64("unzip_file_index_test_cache.zip", entries);
+    {
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(4 == idx.get_entries().size());
+        slassert(3 == idx.find_zip_entry("new.txt").uncomp_length);
+    }
+    {
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(4 == idx.get_entries().size());
+        slassert(3 == idx.find_zip_entry("new.txt").uncomp_length);
+    }
+    // corrupted cache contents, skip is counted from the end of the magic,
+    // inconsistent sections are detected on load and the index is rebuilt
+    std::string magic{"SLUZIDX\0", 8};
+    patch_tail("unzip_file_index_test_cache.idx", magic, 56, 3, 8);
+    {
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(4 == idx.get_entries().size());
+        slassert("foo/bar.txt" == idx.get_entries()[1]);
+        slassert(3 == idx.find_zip_entry("new.txt").uncomp_length);
+    }
+    // records are checked on access: first record name offset, first record offset
+    std::vector<std::pair<size_t, uint64_t>> patches = {{104, 0xfffffff0}, {80, 0xffffffffffffffff}};
+    for (auto& patch : patches) {
+        std::remove("unzip_file_index_test_cache.idx");
+        {
+            uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        }
+        patch_tail("unzip_file_index_test_cache.idx", magic, patch.first, patch.second, 8);
+        uz::file_index idx{"unzip_file_index_test_cache.zip", opts};
+        slassert(3 == idx.get_zip_entry(3).uncomp_length);
+        bool thrown = false;
+        try {
+            idx.get_entry_name(0);
+            idx.get_zip_entry(0);
+        } catch (const uz::unzip_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+}
+
+void test_lazy() {
+    std::vector<gen_entry> entries;
+    entries.emplace_back("dir/", "");
+    for (size_t i = 0; i < 1000; i++) {
+        entries.emplace_back("dir/" + std::to_string(i) + ".txt", std::to_string(i));
+    }
+    write_zip64("unzip_file_index_test_lazy.zip", entries);
+    for (bool mapped : {false, true}) {
+        uz::file_index_options opts;
+        opts.lazy = true;
+        opts.memory_mapped = mapped;
+        opts.collect_stats = true;
+        uz::file_index idx{"unzip_file_index_test_lazy.zip", opts};
+        slassert(0 == idx.get_stats().cd_bytes_parsed);
+        slassert(1 == idx.find_zip_entry("dir/0.txt").uncomp_length);
+        auto parsed_first = idx.get_stats().cd_bytes_parsed;
+        slassert(parsed_first > 0);
+        slassert(-1 == idx.find_zip_entry("dir/").offset);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; t++) {
+            threads.emplace_back([&idx, t] {
+                for (size_t i = t; i < 1000; i += 4) {
+                    auto desc = idx.find_zip_entry("dir/" + std::to_string(i) + ".txt");
+                    slassert(static_cast<int64_t>(std::to_string(i).length()) == desc.uncomp_length);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        slassert(-1 == idx.find_zip_entry("dir/fail.txt").offset);
+        slassert(1001 == idx.get_entries().size());
+        slassert("dir/999.txt" == idx.get_entries().back());
+        auto stream = uz::open_zip_entry(idx, "dir/42.txt");
+        std::string str{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+        slassert("42" == str);
+    }
+    // get_entries without lookups
+    uz::file_index_options opts;
+    opts.lazy = true;
+    uz::file_index idx{"unzip_file_index_test_lazy.zip", opts};
+    slassert(1001 == idx.get_entries().size());
+    slassert(3 == idx.find_zip_entry("dir/999.txt").uncomp_length);
+}
+
+void test_entry_ids() {
+    // names are looked up in place inside a larger buffer
+    std::string buf = "[bundle/aaa.txt][bundle/bbbb.txt]";
+    uz::file_index idx{"../test/data/bundle.zip"};
+    auto desc = idx.find_zip_entry(buf.data() + 1, 14);
+    slassert(144 == desc.offset);
+    slassert(-1 == idx.find_zip_entry(buf.data() + 1, 13).offset);
+    uint32_t id = idx.find_entry_id(buf.data() + 17, 15);
+    slassert("bundle/bbbb.txt" == idx.get_entries()[id]);
+    slassert(65 == idx.get_zip_entry(id).offset);
+    slassert(id == idx.find_entry_id("bundle/bbbb.txt"));
+    slassert(uz::invalid_entry_id == idx.find_entry_id("bundle/"));
+    slassert(uz::invalid_entry_id == idx.find_entry_id("fail"));
+    bool thrown = false;
+    try {
+        idx.get_zip_entry(3);
+    } catch (const uz::unzip_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // ids are positions in the central directory in lazy mode too
+    uz::file_index_options opts;
+    opts.lazy = true;
+    uz::file_index lazy{"unzip_file_index_test_lazy.zip", opts};
+    std::string name = "dir/500.txt";
+    uint32_t lazy_id = lazy.find_entry_id(name.data(), name.length());
+    slassert(501 == lazy_id);
+    slassert(3 == lazy.get_zip_entry(lazy_id).uncomp_length);
+    slassert(1001 == lazy.get_entries().size());
+}
+
+void test_eocd_search() {
+    // comment longer than the initial search buffer
+    std::vector<gen_entry> entries;
+    entries.emplace_back("foo.txt", "foo");
+    write_zip64("unzip_file_index_test_comment.zip", entries, std::string(20000, 'c'));
+    {
+        uz::file_index idx{"unzip_file_index_test_comment.zip"};
+        slassert(3 == idx.find_zip_entry("foo.txt").uncomp_length);
+    }
+    // EOCD signature inside the entry data near the end of file
+    std::string fake_eocd{"PK\x05\x06", 4};
+    fake_eocd.append(18, '\0');
+    entries.emplace_back("fake.bin", fake_eocd);
+    write_zip64("unzip_file_index_test_fake.zip", entries);
+    {
+        uz::file_index idx{"unzip_file_index_test_fake.zip"};
+        slassert(2 == idx.get_entries().size());
+        slassert(22 == idx.find_zip_entry("fake.bin").uncomp_length);
+    }
+}
+
+std::string to_string(sl::io::span<const char> view) {
+    return std::string(view.data(), view.size());
+}
+
+void test_listing() {
+    std::vector<gen_entry> entries;
+    entries.emplace_back("assets/", "");
+    entries.emplace_back("assets/textures/b.png", "b");
+    entries.emplace_back("assets/textures/a.png", "a");
+    entries.emplace_back("assets/textures/sub/c.png", "c");
+    entries.emplace_back("assets/sounds/x.ogg", "x");
+    entries.emplace_back("assets/readme.txt", "r");
+    entries.emplace_back("assets-old/y.png", "y");
+    entries.emplace_back("top.txt", "t");
+    write_zip64("unzip_file_index_test_listing.zip", entries);
+    for (bool lazy : {false, true}) {
+        uz::file_index_options opts;
+        opts.lazy = lazy;
+        uz::file_index idx{"unzip_file_index_test_listing.zip", opts};
+        slassert(entries.size() == idx.get_entries_count());
+
+        auto textures = idx.list_prefix("assets/textures/");
+        slassert(3 == textures.size());
+        slassert("assets/textures/a.png" == to_string(idx.get_entry_name(textures.data()[0])));
+        slassert("assets/textures/b.png" == to_string(idx.get_entry_name(textures.data()[1])));
+        slassert("assets/textures/sub/c.png" == to_string(idx.get_entry_name(textures.data()[2])));
+        slassert(2 == textures.data()[0]);
+        slassert(0 == idx.list_prefix("fail/").size());
+        slassert(entries.size() == idx.list_prefix("").size());
+
+        auto root = idx.list_directory("");
+        slassert(3 == root.size());
+        slassert("assets-old/" == to_string(root[0]));
+        slassert("assets/" == to_string(root[1]));
+        slassert("top.txt" == to_string(root[2]));
+        auto assets = idx.list_directory("assets");
+        slassert(3 == assets.size());
+        slassert("assets/readme.txt" == to_string(assets[0]));
+        slassert("assets/sounds/" == to_string(assets[1]));
+        slassert("assets/textures/" == to_string(assets[2]));
+        slassert(0 == idx.list_directory("fail").size());
+
+        auto pngs = idx.list_glob("assets/*/*.png");
+        slassert(2 == pngs.size());
+        slassert("assets/textures/a.png" == to_string(idx.get_entry_name(pngs[0])));
+        auto all_pngs = idx.list_glob("**/*.png");
+        slassert(4 == all_pngs.size());
+        slassert(3 == idx.list_glob("assets/**/*.png").size());
+        slassert(2 == idx.list_glob("assets/textures/?.png").size());
+        slassert(1 == idx.list_glob("top.txt").size());
+        slassert(0 == idx.list_glob("*.png").size());
+
+        bool thrown = false;
+        try {
+            idx.get_entry_name(static_cast<uint32_t>(entries.size()));
+        } catch (const uz::unzip_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+}
+
+void test_glob() {
+    std::string deep;
+    for (size_t i = 0; i < 30; i++) {
+        deep += "a/";
+    }
+    std::vector<gen_entry> entries;
+    entries.emplace_back("a", "");
+    entries.emplace_back("a/", "");
+    entries.emplace_back("a/x.txt", "x");
+    entries.emplace_back("a/b/y.txt", "y");
+    entries.emplace_back("abc.txt", "z");
+    entries.emplace_back(deep + std::string(40, 'a'), "d");
+    write_zip64("unzip_file_index_test_glob.zip", entries);
+    uz::file_index idx{"unzip_file_index_test_glob.zip"};
+    // trailing "**" does not match the directory itself
+    slassert(4 == idx.list_glob("a/**").size());
+    slassert(2 == idx.list_glob("a/**/*.txt").size());
+    slassert(1 == idx.list_glob("a**c.txt").size());
+    slassert(1 == idx.list_glob("**/a/a/?a*a").size());
+    // backtracking over many stars in long names completes quickly
+    std::string stars;
+    for (size_t i = 0; i < 20; i++) {
+        stars += "**/*a*/";
+    }
+    slassert(1 == idx.list_glob(stars + "*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a").size());
+    slassert(0 == idx.list_glob(stars + "*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*b").size());
+}
+
+void test_mapped() {
+    uz::file_index_options opts;
+    opts.memory_mapped = true;
+    uz::file_index idx{"../test/data/bundle.zip", opts};
+    slassert(idx.is_memory_mapped());
+    slassert(nullptr != idx.get_archive_reader().get());
+    auto desc_aaa = idx.find_zip_entry("bundle/aaa.txt");
+    slassert(144 == desc_aaa.offset);
+    slassert(4 == desc_aaa.comp_length);
+    auto desc_bbbb = idx.find_zip_entry("bundle/bbbb.txt");
+    slassert(65 == desc_bbbb.offset);
+    slassert(8 == desc_bbbb.comp_method);
+    uz::file_index idx_plain{"../test/data/bundle.zip"};
+    slassert(!idx_plain.is_memory_mapped());
+    slassert(nullptr != idx_plain.get_archive_reader().get());
+    slassert(0 == idx_plain.get_archive_reader()->data().size());
+}
+
 int main() {
     try {
         test_entries();
+        test_mapped();
+        test_zip64_many_entries();
+        test_parallel_cd();
+        test_index_cache();
+        test_lazy();
+        test_entry_ids();
+        test_eocd_search();
+        test_listing();
+        test_glob();
+#ifndef STATICLIB_WINDOWS
+        test_zip64_large();
+        test_invalid_zip64();
+#endif // !STATICLIB_WINDOWS
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2015, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   zip_writer.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:40 AM
+ */
+
+#ifndef STATICLIB_UNZIP_TEST_ZIP_WRITER_HPP
+#define STATICLIB_UNZIP_TEST_ZIP_WRITER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "zlib.h"
+
+namespace zip_writer {
+
+/**
+ * Entry to write into the generated archive
+ */
+struct gen_entry {
+    std::string name;
+    std::string data;
+    bool deflate;
+    uint16_t method;
+    std::string comp;
+    uint64_t sparse_len;
+
+    gen_entry(std::string name, std::string data, bool deflate = false) :
+    name(std::move(name)),
+    data(std::move(data)),
+    deflate(deflate),
+    method(deflate ? 8 : 0),
+    sparse_len(0) { }
+
+    // entry already compressed with the specified method
+    gen_entry(std::string name, std::string data, uint16_t method, std::string comp) :
+    name(std::move(name)),
+    data(std::move(data)),
+    deflate(false),
+    method(method),
+    comp(std::move(comp)),
+    sparse_len(0) { }
+
+    // stored entry followed by zeros, written as a hole in a sparse file,
+    // CRC-32 of such entry is not computed and is written as zero
+    gen_entry(std::string name, std::string data, uint64_t sparse_len) :
+    name(std::move(name)),
+    data(std::move(data)),
+    deflate(false),
+    method(0),
+    sparse_len(sparse_len) { }
+
+    uint64_t length() const {
+        return data.length() + sparse_len;
+    }
+};
+
+/**
+ * Options of the generated archive
+ */
+struct archive_options {
+    /**
+     * Whether to write Zip64 end of central directory even if no values overflow
+     */
+    bool zip64 = false;
+
+    /**
+     * Archive comment
+     */
+    std::string comment;
+};
+
+/**
+ * Writes little-endian value
+ *
+ * @param out output stream
+ * @param val value to write
+ * @param len number of bytes to write, no more than 8
+ */
+inline void write_le(std::ostream& out, uint64_t val, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out.put(static_cast<char>((val >> (i * 8)) & 0xff));
+    }
+}
+
+/**
+ * Compresses data with raw deflate as it is stored in ZIP entries
+ *
+ * @param data data to compress
+ * @return compressed data
+ */
+inline std::string deflate_data(const std::string& data) {
+    z_stream strm;
+    std::memset(std::addressof(strm), '\0', sizeof(strm));
+    if (Z_OK != deflateInit2(std::addressof(strm), Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+            Z_DEFAULT_STRATEGY)) {
+        throw std::runtime_error("deflateInit2 error");
+    }
+    std::string res;
+    res.resize(deflateBound(std::addressof(strm), static_cast<uLong>(data.length())));
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    strm.avail_in = static_cast<uInt>(data.length());
+    strm.next_out = reinterpret_cast<Bytef*>(std::addressof(res.front()));
+    strm.avail_out = static_cast<uInt>(res.length());
+    int err = deflate(std::addressof(strm), Z_FINISH);
+    res.resize(strm.total_out);
+    deflateEnd(std::addressof(strm));
+    if (Z_STREAM_END != err) {
+        throw std::runtime_error("deflate error");
+    }
+    return res;
+}
+
+/**
+ * Writes ZIP file with the specified entries to the stream, Zip64 extra fields
+ * are written only for the overflowing values, Zip64 end of central directory
+ * is written when requested or when entries count or central directory
+ * position overflows
+ *
+ * @param out output stream, must support seeking forward for sparse entries
+ * @param entries entries to write
+ * @param options archive options
+ */
+inline void write_archive(std::ostream& out, const std::vector<gen_entry>& entries,
+        const archive_options& options = archive_options()) {
+    const uint64_t max32 = 0xffffffff;
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> comp_lengths;
+    std::vector<uint32_t> crcs;
+    for (auto& en : entries) {
+        offsets.push_back(static_cast<uint64_t>(out.tellp()));
+        std::string deflated = en.deflate ? deflate_data(en.data) : std::string();
+        const std::string& payload = en.deflate ? deflated : 0 != en.method ? en.comp : en.data;
+        uint64_t comp_length = payload.length() + (0 == en.method ? en.sparse_len : 0);
+        comp_lengths.push_back(comp_length);
+        crcs.push_back(0 != en.sparse_len ? 0 : static_cast<uint32_t>(crc32(0,
+                reinterpret_cast<const Bytef*>(en.data.data()), static_cast<uInt>(en.data.length()))));
+        bool big = en.length() >= max32 || comp_length >= max32;
+        write_le(out, 0x04034b50, 4);
+        write_le(out, big || options.zip64 ? 45 : 20, 2);
+        write_le(out, 0, 2);
+        write_le(out, en.method, 2);
+        write_le(out, 0, 4);
+        write_le(out, crcs.back(), 4);
+        write_le(out, big ? max32 : comp_length, 4);
+        write_le(out, big ? max32 : en.length(), 4);
+        write_le(out, en.name.length(), 2);
+        write_le(out, big ? 20 : 0, 2);
+        out.write(en.name.data(), en.name.length());
+        if (big) {
+            // local header holds both lengths
+            write_le(out, 0x0001, 2);
+            write_le(out, 16, 2);
+            write_le(out, en.length(), 8);
+            write_le(out, comp_length, 8);
+        }
+        out.write(payload.data(), payload.length());
+        out.seekp(static_cast<std::streamoff>(en.sparse_len), std::ios::cur);
+    }
+    uint64_t cd_offset = static_cast<uint64_t>(out.tellp());
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto& en = entries[i];
+        // only the overflowing values are written into the extra field, in this order
+        std::vector<uint64_t> zip64_values;
+        for (uint64_t val : {en.length(), comp_lengths[i], offsets[i]}) {
+            if (val >= max32) {
+                zip64_values.push_back(val);
+            }
+        }
+        bool zip64 = !zip64_values.empty() || options.zip64;
+        write_le(out, 0x02014b50, 4);
+        write_le(out, zip64 ? 45 : 20, 2);
+        write_le(out, zip64 ? 45 : 20, 2);
+        write_le(out, 0, 2);
+        write_le(out, en.method, 2);
+        write_le(out, 0, 4);
+        write_le(out, crcs[i], 4);
+        write_le(out, comp_lengths[i] >= max32 ? max32 : comp_lengths[i], 4);
+        write_le(out, en.length() >= max32 ? max32 : en.length(), 4);
+        write_le(out, en.name.length(), 2);
+        write_le(out, zip64_values.empty() ? 0 : 4 + zip64_values.size() * 8, 2);
+        write_le(out, 0, 2);
+        write_le(out, 0, 2);
+        write_le(out, 0, 2);
+        write_le(out, 0, 4);
+        write_le(out, offsets[i] >= max32 ? max32 : offsets[i], 4);
+        out.write(en.name.data(), en.name.length());
+        if (!zip64_values.empty()) {
+            write_le(out, 0x0001, 2);
+            write_le(out, zip64_values.size() * 8, 2);
+            for (uint64_t val : zip64_values) {
+                write_le(out, val, 8);
+            }
+        }
+    }
+    uint64_t eocd64_offset = static_cast<uint64_t>(out.tellp());
+    uint64_t cd_len = eocd64_offset - cd_offset;
+    bool zip64 = options.zip64 || entries.size() >= 0xffff || cd_offset >= max32 || cd_len >= max32;
+    if (zip64) {
+        write_le(out, 0x06064b50, 4);
+        write_le(out, 44, 8);
+        write_le(out, 45, 2);
+        write_le(out, 45, 2);
+        write_le(out, 0, 4);
+        write_le(out, 0, 4);
+        write_le(out, entries.size(), 8);
+        write_le(out, entries.size(), 8);
+        write_le(out, cd_len, 8);
+        write_le(out, cd_offset, 8);
+        write_le(out, 0x07064b50, 4);
+        write_le(out, 0, 4);
+        write_le(out, eocd64_offset, 8);
+        write_le(out, 1, 4);
+    }
+    write_le(out, 0x06054b50, 4);
+    write_le(out, 0, 2);
+    write_le(out, 0, 2);
+    write_le(out, zip64 ? 0xffff : entries.size(), 2);
+    write_le(out, zip64 ? 0xffff : entries.size(), 2);
+    write_le(out, zip64 ? max32 : cd_len, 4);
+    write_le(out, zip64 ? max32 : cd_offset, 4);
+    write_le(out, options.comment.length(), 2);
+    out.write(options.comment.data(), options.comment.length());
+}
+
+/**
+ * Writes ZIP file with the specified entries to the file
+ *
+ * @param path output path
+ * @param entries entries to write
+ * @param options archive options
+ */
+inline void write_archive(const std::string& path, const std::vector<gen_entry>& entries,
+        const archive_options& options = archive_options()) {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    write_archive(out, entries, options);
+}
+
+/**
+ * Builds ZIP file with the specified entries in memory, sparse entries are not supported
+ *
+ * @param entries entries to write
+ * @param options archive options
+ * @return ZIP file contents
+ */
+inline std::string make_archive(const std::vector<gen_entry>& entries,
+        const archive_options& options = archive_options()) {
+    std::ostringstream out;
+    write_archive(out, entries, options);
+    return out.str();
+}
+
+} // namespace
+
+#endif /* STATICLIB_UNZIP_TEST_ZIP_WRITER_HPP */